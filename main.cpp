@@ -1,9 +1,13 @@
+#include <chrono>
+#include <format>
 #include <iostream>
 #include <stdexcept>
 
 #include "renderGraph/InputData.h"
 #include "renderGraph/RenderGraph.h"
 #include "renderGraph/compiler/RGCompiler.h"
+#include "renderGraph/executor/RGExecutor.h"
+#include "renderGraph/executor/RGPlanReplayer.h"
 
 int main()
 {
@@ -17,16 +21,72 @@ int main()
         return 1;
     }
 
-    constexpr RGCompilerOptions compilerOptions = {
+    const RGCompilerOptions compilerOptions = {
         .allowParallelization = true,
+        .planCacheDirectory   = "cache",
     };
     const RenderGraphCompiler compiler(renderGraph.get(), compilerOptions);
-    try {
-        auto result = compiler.compile();
-    } catch (const std::exception& e) {
-        std::cerr << e.what() << std::endl;
+
+    // Warm startup : Replay the cached plan of the graph, only compile it on a cache miss.
+    const auto cachedPlan = compiler.loadCachedPlan();
+    std::cout << std::format("Plan cache : {}", cachedPlan.has_value() ? "hit" : "miss") << std::endl;
+
+    RGCompilerOutput result;
+    if (!cachedPlan.has_value())
+    {
+        try {
+            result = compiler.compile();
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+
+        if (result.hasFailed)
+        {
+            std::cerr << std::format("Compilation failed : {}", toString(result.failReason)) << std::endl;
+            return 1;
+        }
+        compiler.storeCachedPlan(result);
+    }
+
+    // Replay the lowered execution plan with simulated command recording.
+    constexpr int32_t frameCount = 100;
+    const RGSimulatedBackend backend = { .cost = std::chrono::microseconds(100) };
+
+    const RGExecutionPlanView plan = cachedPlan.has_value() ? cachedPlan->plan : result.executionPlan.view();
+    const RGPlanReplayer replayer(*renderGraph, plan, backend);
+    if (!replayer.isValid())
+    {
+        std::cerr << "Invalid execution plan" << std::endl;
         return 1;
     }
 
+    RGPlanReplayStats replayStats;
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < frameCount; i++)
+    {
+        replayStats = replayer.run();
+    }
+    const std::chrono::duration<double, std::micro> replayTime = (std::chrono::steady_clock::now() - start) / frameCount;
+
+    std::cout << std::format("Replayed {} frames : {:.1f} us / frame, {} submits, {} waits, {} B arena",
+        frameCount, replayTime.count(), replayStats.submits, replayStats.waits, replayStats.arenaHighWater) << std::endl;
+
+    // Execute the compiled graph on the work-stealing executor for comparison, it needs the full compiler output.
+    if (!cachedPlan.has_value())
+    {
+        RGExecutor executor(*renderGraph, result, backend);
+
+        start = std::chrono::steady_clock::now();
+        for (int32_t i = 0; i < frameCount; i++)
+        {
+            executor.run();
+        }
+        const std::chrono::duration<double, std::micro> frameTime = (std::chrono::steady_clock::now() - start) / frameCount;
+
+        std::cout << std::format("Executed {} frames on {} workers : {:.1f} us / frame, {} steals",
+            frameCount, executor.workerCount(), frameTime.count(), executor.stealCount()) << std::endl;
+    }
+
     return 0;
 }
\ No newline at end of file
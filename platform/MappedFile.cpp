@@ -0,0 +1,130 @@
+#include "MappedFile.h"
+
+#include <utility>
+
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    release();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+: mData(std::exchange(other.mData, nullptr))
+, mSize(std::exchange(other.mSize, 0))
+#ifdef _WIN32
+, mMapping(std::exchange(other.mMapping, nullptr))
+#endif
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        mData = std::exchange(other.mData, nullptr);
+        mSize = std::exchange(other.mSize, 0);
+#ifdef _WIN32
+        mMapping = std::exchange(other.mMapping, nullptr);
+#endif
+    }
+    return *this;
+}
+
+#ifdef _WIN32
+std::optional<MappedFile> MappedFile::open(const std::filesystem::path& path)
+{
+    const HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return std::nullopt;
+    }
+
+    LARGE_INTEGER size = {};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return std::nullopt;
+    }
+
+    const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping)
+    {
+        return std::nullopt;
+    }
+
+    const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(mapping);
+        return std::nullopt;
+    }
+
+    MappedFile result;
+    result.mData    = static_cast<const std::byte*>(view);
+    result.mSize    = static_cast<size_t>(size.QuadPart);
+    result.mMapping = mapping;
+    return result;
+}
+
+void MappedFile::release() noexcept
+{
+    if (mData)
+    {
+        UnmapViewOfFile(mData);
+        CloseHandle(mMapping);
+    }
+    mData    = nullptr;
+    mSize    = 0;
+    mMapping = nullptr;
+}
+#else
+std::optional<MappedFile> MappedFile::open(const std::filesystem::path& path)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        return std::nullopt;
+    }
+
+    struct stat st = {};
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return std::nullopt;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED)
+    {
+        return std::nullopt;
+    }
+
+    MappedFile result;
+    result.mData = static_cast<const std::byte*>(view);
+    result.mSize = static_cast<size_t>(st.st_size);
+    return result;
+}
+
+void MappedFile::release() noexcept
+{
+    if (mData)
+    {
+        munmap(const_cast<std::byte*>(mData), mSize);
+    }
+    mData = nullptr;
+    mSize = 0;
+}
+#endif
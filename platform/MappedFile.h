@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+
+/**
+ * Read-only memory mapping of a whole file, unmapped on destruction.
+ * The mapping starts at a page boundary, so data in the file keeps the alignment of its file offset.
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /** @return Mapping of the file, std::nullopt if it doesn't exist, is empty or can't be mapped. */
+    static std::optional<MappedFile> open(const std::filesystem::path& path);
+
+    std::span<const std::byte> data() const noexcept { return { mData, mSize }; }
+
+private:
+    void release() noexcept;
+
+    const std::byte* mData = nullptr;
+    size_t           mSize = 0;
+#ifdef _WIN32
+    void*            mMapping = nullptr;
+#endif
+};
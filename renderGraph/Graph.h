@@ -1,31 +1,165 @@
 #pragma once
 
+#include <algorithm>
+#include <concepts>
 #include <cstdint>
 #include <expected>
-#include <set>
+#include <queue>
+#include <ranges>
+#include <span>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+/** Adjacency of a vertex in a pointer based graph, <T> is the vertex type deriving from it. */
+template <class T>
 struct Vertex
 {
-    virtual ~Vertex() = default;
+    int32_t         mId = -1;
+    std::vector<T*> mIncomingEdges;
+    std::vector<T*> mOutgoingEdges;
+};
+
+// =======================================
+// Graph : Adjacency
+// =======================================
+
+/** Graph of the vertices [0, vertexCount()), successors(v) is a range of the vertices <v> has an edge to. */
+template <class G>
+concept AdjacencyGraph = requires(const G& graph, const uint32_t vertex)
+{
+    { graph.vertexCount() } -> std::convertible_to<uint32_t>;
+    { graph.successors(vertex) } -> std::ranges::input_range;
+    requires std::convertible_to<std::ranges::range_value_t<decltype(graph.successors(vertex))>, uint32_t>;
+};
+
+/** Compressed sparse row adjacency, the successors of <v> are targets[offsets[v], offsets[v + 1]). */
+struct CSRGraph
+{
+    std::vector<uint32_t> offsets = { 0 };
+    std::vector<uint32_t> targets;
+
+    uint32_t vertexCount() const noexcept { return static_cast<uint32_t>(offsets.size() - 1); }
+
+    std::span<const uint32_t> successors(const uint32_t vertex) const noexcept
+    {
+        return std::span(targets).subspan(offsets[vertex], offsets[vertex + 1] - offsets[vertex]);
+    }
+};
+
+/**
+ * Adjacency view of a list of pointer vertices, vertices are addressed by their position in the list.
+ * Edges to vertices which are not in the list are ignored. The list has to outlive the view.
+ */
+template <class T>
+class VertexListGraph
+{
+public:
+    explicit VertexListGraph(const std::span<T* const> vertices)
+    : mVertices(vertices)
+    {
+        mIndexOf.reserve(vertices.size());
+        for (uint32_t i = 0; i < vertices.size(); i++)
+        {
+            mIndexOf.emplace(vertices[i], i);
+        }
+    }
+
+    uint32_t vertexCount() const noexcept { return static_cast<uint32_t>(mVertices.size()); }
 
-    int32_t              mId = -1;
-    std::vector<Vertex*> mIncomingEdges;
-    std::vector<Vertex*> mOutgoingEdges;
+    T* vertex(const uint32_t index) const noexcept { return mVertices[index]; }
+
+    /** @return Position of the vertex in the list, UINT32_MAX if it is not in the list. */
+    uint32_t indexOf(const T* vertex) const noexcept
+    {
+        const auto it = mIndexOf.find(vertex);
+        return it == std::end(mIndexOf) ? UINT32_MAX : it->second;
+    }
+
+    auto successors(const uint32_t index) const
+    {
+        return mVertices[index]->mOutgoingEdges
+            | std::views::transform([this](const T* w){ return indexOf(w); })
+            | std::views::filter([](const uint32_t w){ return w != UINT32_MAX; });
+    }
+
+private:
+    std::span<T* const>                    mVertices;
+    std::unordered_map<const T*, uint32_t> mIndexOf;
 };
 
+template <class T>
+VertexListGraph(const std::vector<T*>&) -> VertexListGraph<T>;
+
+// =======================================
+// Graph : Algorithms
+// =======================================
+
 // BFS and algorithms based on it.
 struct BFS
 {
     /**
-     * @return Set of vertex IDs which were visited during execution.
+     * @return Vertices which were visited during execution, in visiting order.
      */
-    static std::set<int32_t> execute(Vertex* root);
+    template <AdjacencyGraph G>
+    static std::vector<uint32_t> execute(const G& graph, const uint32_t root)
+    {
+        std::vector<bool>     visited(graph.vertexCount(), false);
+        std::vector<uint32_t> order = { root };
+        visited[root] = true;
+
+        // The visiting order doubles as the queue.
+        for (size_t head = 0; head < order.size(); head++)
+        {
+            for (const uint32_t w : graph.successors(order[head]))
+            {
+                if (!visited[w])
+                {
+                    visited[w] = true;
+                    order.push_back(w);
+                }
+            }
+        }
+
+        return order;
+    }
 
     /**
      * @return Does a path exist from A to B
      */
-    static bool hasPath(Vertex* src, Vertex* dst);
+    template <AdjacencyGraph G>
+    static bool hasPath(const G& graph, const uint32_t src, const uint32_t dst)
+    {
+        if (src == dst)
+        {
+            return true;
+        }
+
+        std::vector<bool>     visited(graph.vertexCount(), false);
+        std::vector<uint32_t> stack = { src };
+        visited[src] = true;
+
+        while (!stack.empty())
+        {
+            const uint32_t current = stack.back();
+            stack.pop_back();
+
+            for (const uint32_t neighbor : graph.successors(current))
+            {
+                if (neighbor == dst)
+                {
+                    return true;
+                }
+
+                if (!visited[neighbor])
+                {
+                    visited[neighbor] = true;
+                    stack.push_back(neighbor);
+                }
+            }
+        }
+        return false;
+    }
 };
 
 // Topological Sort for directed (acyclic) graphs.
@@ -37,7 +171,145 @@ struct TopologicalSort
     };
 
     /**
-     * @return List of Vertex IDs in topological order.
+     * Kahn's algorithm, vertices without incoming edges are queued in ascending order.
+     * @return List of vertices in topological order.
      */
-    static std::expected<std::vector<int32_t>, Error> execute(const std::vector<Vertex*>& vertices) noexcept;
+    template <AdjacencyGraph G>
+    static std::expected<std::vector<uint32_t>, Error> execute(const G& graph)
+    {
+        const uint32_t n = graph.vertexCount();
+
+        std::vector<int32_t> inDegrees(n, 0);
+        for (uint32_t v = 0; v < n; v++)
+        {
+            for (const uint32_t w : graph.successors(v))
+            {
+                inDegrees[w]++;
+            }
+        }
+
+        std::queue<uint32_t> Q;
+        for (uint32_t v = 0; v < n; v++)
+        {
+            if (inDegrees[v] == 0)
+            {
+                Q.push(v);
+            }
+        }
+
+        std::vector<uint32_t> T;
+        T.reserve(n);
+        while (!Q.empty())
+        {
+            const uint32_t v = Q.front();
+            Q.pop();
+            T.push_back(v);
+
+            for (const uint32_t w : graph.successors(v))
+            {
+                if (--inDegrees[w] == 0)
+                {
+                    Q.push(w);
+                }
+            }
+        }
+
+        if (T.size() != n)
+        {
+            return std::unexpected(Error::GraphNotAcyclic);
+        }
+        return T;
+    }
+};
+
+/** Reachability between the vertices of a directed acyclic graph, one bitset row per vertex. */
+struct Reachability
+{
+    std::vector<uint32_t> topoIndex;    // Vertex -> topological index, bits and rows are addressed by it
+    std::vector<uint64_t> rows;         // Per topological index, set of topological indices reachable from it
+    size_t                words = 0;    // Words per row
+
+    /** @return Whether a path of at least one edge leads from <src> to <dst>. */
+    bool reaches(const uint32_t src, const uint32_t dst) const noexcept
+    {
+        const uint32_t bit = topoIndex[dst];
+        return (rows[topoIndex[src] * words + bit / 64] >> (bit % 64)) & 1;
+    }
+};
+
+// Transitive reduction for directed acyclic graphs.
+struct TransitiveReduction
+{
+    using Error = TopologicalSort::Error;
+
+    struct Result
+    {
+        std::vector<std::pair<uint32_t, uint32_t>> edges;           // (src, dst) vertex pairs of the reduction
+        Reachability                               reachability;    // Reachability of the full graph
+    };
+
+    /**
+     * Reachability is tracked as one bitset per vertex, successors are visited in topological order
+     * and an edge is only kept if its target is not already reachable through an earlier successor.
+     * @return List of (src, dst) vertex pairs with every edge implied by a longer path removed, and the reach rows built for it.
+     */
+    template <AdjacencyGraph G>
+    static std::expected<Result, Error> execute(const G& graph)
+    {
+        const auto tsortResult = TopologicalSort::execute(graph);
+        if (!tsortResult.has_value())
+        {
+            return std::unexpected(tsortResult.error());
+        }
+
+        const auto& sorted = tsortResult.value();
+        const auto  n      = static_cast<uint32_t>(sorted.size());
+
+        Result result;
+        auto& [edges, reachability] = result;
+        auto& [topoIndex, reach, words] = reachability;
+
+        topoIndex.resize(n);
+        for (uint32_t i = 0; i < n; i++)
+        {
+            topoIndex[sorted[i]] = i;
+        }
+
+        // reach[i] : Set of topological indices reachable from vertex i.
+        words = (static_cast<size_t>(n) + 63) / 64;
+        reach.resize(static_cast<size_t>(n) * words, 0);
+
+        std::vector<uint32_t> successors;
+        for (uint32_t i = n; i-- > 0;)
+        {
+            successors.clear();
+            for (const uint32_t w : graph.successors(sorted[i]))
+            {
+                successors.push_back(topoIndex[w]);
+            }
+            std::ranges::sort(successors);
+
+            uint64_t* row = &reach[static_cast<size_t>(i) * words];
+            for (const auto s : successors)
+            {
+                const uint64_t bit = uint64_t { 1 } << (s % 64);
+                if (row[s / 64] & bit)
+                {
+                    continue;
+                }
+
+                edges.emplace_back(sorted[i], sorted[s]);
+                row[s / 64] |= bit;
+
+                const uint64_t* successorRow = &reach[static_cast<size_t>(s) * words];
+                for (size_t k = 0; k < words; k++)
+                {
+                    row[k] |= successorRow[k];
+                }
+            }
+        }
+
+        std::ranges::reverse(edges);
+        return result;
+    }
 };
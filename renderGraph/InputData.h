@@ -3,6 +3,34 @@
 #include "IdSequence.h"
 #include "RenderGraphCore.h"
 
+/**
+ * Descriptions of the example resources at 1920x1080.
+ * Compatibility keys use Vulkan format and usage values.
+ */
+namespace Descs
+{
+    constexpr uint64_t pixelCount = 1920 * 1080;
+
+    constexpr uint32_t formatR8Unorm       = 9;     // VK_FORMAT_R8_UNORM
+    constexpr uint32_t formatRGBA8Unorm    = 37;    // VK_FORMAT_R8G8B8A8_UNORM
+    constexpr uint32_t formatRG16Sfloat    = 83;    // VK_FORMAT_R16G16_SFLOAT
+    constexpr uint32_t formatRGBA16Sfloat  = 97;    // VK_FORMAT_R16G16B16A16_SFLOAT
+
+    constexpr uint32_t usageTarget  = 0x14;         // COLOR_ATTACHMENT | SAMPLED
+    constexpr uint32_t usageStorage = 0x0C;         // STORAGE | SAMPLED
+
+    constexpr ResourceDesc rgba16fTarget = { .size = pixelCount * 8, .compatibility = { .format = formatRGBA16Sfloat, .usage = usageTarget } };
+    constexpr ResourceDesc rgba8Target   = { .size = pixelCount * 4, .compatibility = { .format = formatRGBA8Unorm, .usage = usageTarget } };
+    constexpr ResourceDesc rg16fTarget   = { .size = pixelCount * 4, .compatibility = { .format = formatRG16Sfloat, .usage = usageTarget } };
+    constexpr ResourceDesc rgba8Storage  = { .size = pixelCount * 4, .compatibility = { .format = formatRGBA8Unorm, .usage = usageStorage } };
+    constexpr ResourceDesc r8Storage     = { .size = pixelCount, .compatibility = { .format = formatR8Unorm, .usage = usageStorage } };
+
+    // Buffers only need a size, 16x16 pixel tiles with up to 256 light indices each.
+    constexpr uint64_t     tileCount      = (1920 / 16) * (1080 / 16 + 1);
+    constexpr ResourceDesc lightGrid      = { .size = tileCount * 8, .compatibility = {} };
+    constexpr ResourceDesc lightIndexList = { .size = tileCount * 256 * 4, .compatibility = {} };
+}
+
 namespace Passes
 {
     inline PassPtr computeAmbientOcclusion()
@@ -19,9 +47,9 @@ namespace Passes
                 .async = true,
         };
         pass->dependencies = {
-            Resource { IdSequence::next(), "positionImage", Image, Read },
-            Resource { IdSequence::next(), "normalImage", Image, Read },
-            Resource { IdSequence::next(), "ambientOcclusionImage", Image, Write },
+            Resource { IdSequence::next(), "positionImage", Image, Read, {}, {} },
+            Resource { IdSequence::next(), "normalImage", Image, Read, {}, {} },
+            Resource { IdSequence::next(), "ambientOcclusionImage", Image, Write, {}, Descs::r8Storage },
         };
 
         return pass;
@@ -40,8 +68,8 @@ namespace Passes
             .async = true,
         };
         pass->dependencies = {
-            Resource { IdSequence::next(), "scene", External, None },
-            Resource { IdSequence::next(), "someImage", Image, Write },
+            Resource { IdSequence::next(), "scene", External, None, {}, {} },
+            Resource { IdSequence::next(), "someImage", Image, Write, {}, Descs::rgba8Storage },
         };
 
         return pass;
@@ -59,11 +87,11 @@ namespace Passes
             .raster = true,
         };
         pass->dependencies = {
-            Resource { IdSequence::next(), "scene", External, None },
-            Resource { IdSequence::next(), "positionImage", Image, Write },
-            Resource { IdSequence::next(), "normalImage", Image, Write },
-            Resource { IdSequence::next(), "albedoImage", Image, Write },
-            Resource { IdSequence::next(), "motionVectors", Image, Write },
+            Resource { IdSequence::next(), "scene", External, None, {}, {} },
+            Resource { IdSequence::next(), "positionImage", Image, Write, {}, Descs::rgba16fTarget },
+            Resource { IdSequence::next(), "normalImage", Image, Write, {}, Descs::rgba16fTarget },
+            Resource { IdSequence::next(), "albedoImage", Image, Write, {}, Descs::rgba8Target },
+            Resource { IdSequence::next(), "motionVectors", Image, Write, {}, Descs::rg16fTarget },
         };
 
         return pass;
@@ -81,10 +109,53 @@ namespace Passes
             .raster = true,
         };
         pass->dependencies = {
-            Resource { IdSequence::next(), "positionImage", Image, Read },
-            Resource { IdSequence::next(), "normalImage", Image, Read },
-            Resource { IdSequence::next(), "albedoImage", Image, Read },
-            Resource { IdSequence::next(), "lightingResult", Image, Write },
+            Resource { IdSequence::next(), "positionImage", Image, Read, {}, {} },
+            Resource { IdSequence::next(), "normalImage", Image, Read, {}, {} },
+            Resource { IdSequence::next(), "albedoImage", Image, Read, {}, {} },
+            Resource { IdSequence::next(), "lightingResult", Image, Write, {}, Descs::rgba16fTarget },
+        };
+
+        return pass;
+    }
+
+    inline PassPtr computeLightCulling()
+    {
+        using enum ResourceType;
+        using enum AccessType;
+        auto pass = std::make_unique<Pass>();
+
+        pass->mId = IdSequence::next();
+        pass->name = "Light Culling Pass";
+        pass->flags = {
+            .compute = true,
+        };
+        pass->dependencies = {
+            Resource { IdSequence::next(), "positionImage", Image, Read, {}, {} },
+            Resource { IdSequence::next(), "lightGrid", Buffer, Write, {}, Descs::lightGrid },
+            Resource { IdSequence::next(), "lightIndexList", Buffer, Write, {}, Descs::lightIndexList },
+        };
+
+        return pass;
+    }
+
+    inline PassPtr graphicsTiledLightingPass()
+    {
+        using enum ResourceType;
+        using enum AccessType;
+        auto pass = std::make_unique<Pass>();
+
+        pass->mId = IdSequence::next();
+        pass->name = "Tiled Lighting Pass";
+        pass->flags = {
+            .raster = true,
+        };
+        pass->dependencies = {
+            Resource { IdSequence::next(), "positionImage", Image, Read, {}, {} },
+            Resource { IdSequence::next(), "normalImage", Image, Read, {}, {} },
+            Resource { IdSequence::next(), "albedoImage", Image, Read, {}, {} },
+            Resource { IdSequence::next(), "lightGrid", Buffer, Read, {}, {} },
+            Resource { IdSequence::next(), "lightIndexList", Buffer, Read, {}, {} },
+            Resource { IdSequence::next(), "lightingResult", Image, Write, {}, Descs::rgba16fTarget },
         };
 
         return pass;
@@ -102,9 +173,9 @@ namespace Passes
             .raster = true,
         };
         pass->dependencies = {
-            Resource { IdSequence::next(), "imageA", Image, Read },
-            Resource { IdSequence::next(), "imageB", Image, Read },
-            Resource { IdSequence::next(), "combined", Image, Write },
+            Resource { IdSequence::next(), "imageA", Image, Read, {}, {} },
+            Resource { IdSequence::next(), "imageB", Image, Read, {}, {} },
+            Resource { IdSequence::next(), "combined", Image, Write, {}, Descs::rgba16fTarget },
         };
 
         return pass;
@@ -122,9 +193,9 @@ namespace Passes
             .raster = true,
         };
         pass->dependencies = {
-            Resource { IdSequence::next(), "motionVectors", Image, Read },
-            Resource { IdSequence::next(), "aaInput", Image, Read },
-            Resource { IdSequence::next(), "aaOutput", Image, Write },
+            Resource { IdSequence::next(), "motionVectors", Image, Read, {}, {} },
+            Resource { IdSequence::next(), "aaInput", Image, Read, {}, {} },
+            Resource { IdSequence::next(), "aaOutput", Image, Write, {}, Descs::rgba16fTarget },
         };
 
         return pass;
@@ -144,7 +215,7 @@ namespace Passes
             .sentinel = true,
         };
         pass->dependencies = {
-            Resource { IdSequence::next(), "presentImage", Image, Read },
+            Resource { IdSequence::next(), "presentImage", Image, Read, {}, {} },
         };
 
         return pass;
@@ -163,7 +234,7 @@ namespace Passes
             .sentinel = true,
         };
         pass->dependencies = {
-            Resource { IdSequence::next(), "scene", External, None },
+            Resource { IdSequence::next(), "scene", External, None, {}, {} },
         };
 
         return pass;
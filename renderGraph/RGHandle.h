@@ -0,0 +1,41 @@
+#pragma once
+
+#include <compare>
+#include <cstdint>
+
+struct Pass;
+struct Edge;
+
+// =======================================
+// Render Graph : Handles
+// =======================================
+
+/**
+ * Slot index + generation of an object owned by a RenderGraph.
+ * Deleting the object bumps the generation of its slot, stale handles then fail the checked lookup
+ * instead of dangling, even if the slot is reused.
+ */
+template <class T>
+struct RGHandle
+{
+    uint32_t index      = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool isValid() const noexcept { return index != UINT32_MAX; }
+
+    auto operator<=>(const RGHandle&) const = default;
+};
+
+using RGPassHandle = RGHandle<Pass>;
+using RGEdgeHandle = RGHandle<Edge>;
+
+/** Resources live and die with their pass, they are addressed by the pass handle and their index within the pass. */
+struct RGResourceHandle
+{
+    RGPassHandle pass;
+    uint32_t     resource = UINT32_MAX;
+
+    bool isValid() const noexcept { return pass.isValid() && resource != UINT32_MAX; }
+
+    auto operator<=>(const RGResourceHandle&) const = default;
+};
@@ -0,0 +1,110 @@
+#include "RGPassTable.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include "RenderGraph.h"
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+
+RGPassTable::RGPassTable(const RenderGraph& renderGraph)
+{
+    uint32_t slotCount = 0;
+    size_t   resourceCount = 0;
+    for (const auto& pass : renderGraph.getVertices())
+    {
+        slotCount = std::max(slotCount, pass->handle.index + 1);
+        resourceCount += pass->dependencies.size();
+    }
+
+    mPasses.resize(slotCount, nullptr);
+    mIds.resize(slotCount, rgInvalidId);
+    mFlagBits.resize(slotCount, 0);
+    mNameSymbols.resize(slotCount, UINT32_MAX);
+    mResourceRanges.resize(slotCount);
+    mResourceIds.reserve(resourceCount);
+    mSlotOfId.reserve(renderGraph.getVertices().size());
+
+    for (const auto& pass : renderGraph.getVertices())
+    {
+        const uint32_t slot = pass->handle.index;
+        mPasses[slot]      = pass.get();
+        mIds[slot]         = pass->mId;
+        mFlagBits[slot]    = pass->flags.bits();
+        mSlotOfId.emplace(pass->mId, slot);
+        mNameSymbols[slot] = mSymbols.try_emplace(pass->name, static_cast<uint32_t>(mSymbols.size())).first->second;
+
+        mResourceRanges[slot] = {
+            .first = static_cast<uint32_t>(mResourceIds.size()),
+            .count = static_cast<uint32_t>(pass->dependencies.size()),
+        };
+        for (const auto& resource : pass->dependencies)
+        {
+            mResourceIds.push_back(resource.id);
+        }
+    }
+}
+
+uint32_t RGPassTable::slotOf(const Id_t id) const noexcept
+{
+    const auto it = mSlotOfId.find(id);
+    return it == std::end(mSlotOfId) ? UINT32_MAX : it->second;
+}
+
+std::optional<uint32_t> RGPassTable::findSymbol(const std::string_view name) const noexcept
+{
+    const auto it = mSymbols.find(name);
+    return it == std::end(mSymbols) ? std::nullopt : std::optional(it->second);
+}
+
+std::vector<uint32_t> RGPassTable::select(const uint8_t mask) const
+{
+    std::vector<uint32_t> slots;
+
+    const auto count = static_cast<uint32_t>(mFlagBits.size());
+    const uint8_t* bits = mFlagBits.data();
+
+    uint32_t i = 0;
+#if defined(__AVX2__)
+    const __m256i vMask = _mm256_set1_epi8(static_cast<char>(mask));
+    for (; i + 32 <= count; i += 32)
+    {
+        const __m256i v     = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bits + i));
+        const __m256i match = _mm256_cmpeq_epi8(_mm256_and_si256(v, vMask), vMask);
+        for (auto matches = static_cast<uint32_t>(_mm256_movemask_epi8(match)); matches != 0; matches &= matches - 1)
+        {
+            slots.push_back(i + std::countr_zero(matches));
+        }
+    }
+#endif
+    // SWAR : A byte of <x> is zero where all mask bits are set, the high bit of each zero byte is extracted.
+    constexpr uint64_t lowBits  = 0x7F7F7F7F7F7F7F7Full;
+    const uint64_t     vMask64  = 0x0101010101010101ull * mask;
+    for (; i + 8 <= count; i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, bits + i, sizeof(word));
+        if constexpr (std::endian::native == std::endian::big)
+        {
+            word = std::byteswap(word);
+        }
+
+        const uint64_t x = (word & vMask64) ^ vMask64;
+        for (uint64_t matches = ~(((x & lowBits) + lowBits) | x | lowBits); matches != 0; matches &= matches - 1)
+        {
+            slots.push_back(i + std::countr_zero(matches) / 8);
+        }
+    }
+    for (; i < count; i++)
+    {
+        if ((bits[i] & mask) == mask)
+        {
+            slots.push_back(i);
+        }
+    }
+
+    return slots;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "RenderGraphCore.h"
+
+class RenderGraph;
+
+/** Pass slots selected from an RGPassTable, membership is tested by slot without touching the passes. */
+class RGPassSelection
+{
+public:
+    RGPassSelection(const uint32_t slotCount, const std::span<const uint32_t> slots)
+    : mWords((slotCount + 63) / 64, 0)
+    {
+        for (const uint32_t slot : slots)
+        {
+            mWords[slot / 64] |= uint64_t { 1 } << (slot % 64);
+        }
+    }
+
+    bool contains(const uint32_t slot) const noexcept
+    {
+        return (mWords[slot / 64] >> (slot % 64)) & 1;
+    }
+
+private:
+    std::vector<uint64_t> mWords;
+};
+
+// =======================================
+// Render Graph : Pass Table
+// =======================================
+
+/**
+ * Struct-of-arrays snapshot of the passes of a RenderGraph, for analyses which read one or two fields of every pass.
+ * Columns are indexed by pass slot (RGPassHandle::index), slots of deleted passes hold no flags and rgInvalidId.
+ * Names are interned as symbols, dependencies are stored as ranges of one flat resource ID column.
+ * The snapshot is not updated, it has to be rebuilt after the graph was modified.
+ */
+class RGPassTable
+{
+public:
+    explicit RGPassTable(const RenderGraph& renderGraph);
+
+    uint32_t size() const noexcept { return static_cast<uint32_t>(mIds.size()); }
+
+    Pass*    pass(const uint32_t slot)       const noexcept { return mPasses[slot]; }
+    Id_t     id(const uint32_t slot)         const noexcept { return mIds[slot]; }
+    uint8_t  flagBits(const uint32_t slot)   const noexcept { return mFlagBits[slot]; }
+    uint32_t nameSymbol(const uint32_t slot) const noexcept { return mNameSymbols[slot]; }
+
+    std::span<const Id_t> resourceIds(const uint32_t slot) const noexcept
+    {
+        return std::span(mResourceIds).subspan(mResourceRanges[slot].first, mResourceRanges[slot].count);
+    }
+
+    /** @return Slot of the pass with the given ID, UINT32_MAX if there is none. */
+    uint32_t slotOf(Id_t id) const noexcept;
+
+    /** @return Symbol of a pass name, std::nullopt if no pass has that name. */
+    std::optional<uint32_t> findSymbol(std::string_view name) const noexcept;
+
+    /**
+     * Scan the flag column for passes which have all flags of <mask> set, <mask> must not be 0.
+     * 32 (AVX2) or 8 (SWAR) passes are tested per step.
+     * @return Slots of the matching passes in ascending order.
+     */
+    std::vector<uint32_t> select(uint8_t mask) const;
+
+    /** select() as a set, for phases which test many passes against the same mask. */
+    RGPassSelection selectSet(const uint8_t mask) const { return RGPassSelection(size(), select(mask)); }
+
+private:
+    struct ResourceRange
+    {
+        uint32_t first = 0;
+        uint32_t count = 0;
+    };
+
+    std::vector<Pass*>         mPasses;
+    std::vector<Id_t>          mIds;
+    std::vector<uint8_t>       mFlagBits;
+    std::vector<uint32_t>      mNameSymbols;
+    std::vector<ResourceRange> mResourceRanges;
+    std::vector<Id_t>          mResourceIds;
+
+    std::unordered_map<Id_t, uint32_t>             mSlotOfId;
+    std::unordered_map<std::string_view, uint32_t> mSymbols;   // Views into the pass names
+};
@@ -6,8 +6,39 @@
 #include <ranges>
 #include "InputData.h"
 
+namespace
+{
+    /** @return Index of a free slot, slots of deleted objects are reused first. */
+    template <class Slot>
+    uint32_t acquireSlot(std::vector<Slot>& slots, std::vector<uint32_t>& freeSlots)
+    {
+        if (freeSlots.empty())
+        {
+            slots.emplace_back();
+            return static_cast<uint32_t>(slots.size() - 1);
+        }
+
+        const uint32_t slotIdx = freeSlots.back();
+        freeSlots.pop_back();
+        return slotIdx;
+    }
+
+    /** Invalidate all handles to the slot and make it reusable. */
+    template <class Slot>
+    void releaseSlot(std::vector<Slot>& slots, std::vector<uint32_t>& freeSlots, const uint32_t slotIdx)
+    {
+        const uint32_t generation = slots[slotIdx].generation;
+        slots[slotIdx] = { .generation = generation + 1 };
+        freeSlots.push_back(slotIdx);
+    }
+}
+
 Pass* RenderGraph::addPass(std::unique_ptr<Pass>&& vtx)
 {
+    const uint32_t slotIdx = acquireSlot(mPassSlots, mFreePassSlots);
+    mPassSlots[slotIdx].pass = vtx.get();
+    vtx->handle = { .index = slotIdx, .generation = mPassSlots[slotIdx].generation };
+
     mVertices.push_back(std::move(vtx));
     return mVertices.back().get();
 }
@@ -20,10 +51,27 @@ bool RenderGraph::deletePass(const Id_t passId)
         return false;
     }
 
-    std::erase_if(mEdges, [pass](const Edge& edge) {
+    const auto touchesPass = [pass](const Edge& edge) {
         return edge.src->getId() == pass->getId()
             || edge.dst->getId() == pass->getId();
-    });
+    };
+    for (const auto& edge : mEdges | std::views::filter(touchesPass))
+    {
+        releaseSlot(mEdgeSlots, mFreeEdgeSlots, edge.handle.index);
+    }
+    std::erase_if(mEdges, touchesPass);
+    reindexEdgeSlots(0);
+
+    for (auto* neighbour : pass->mIncomingEdges)
+    {
+        std::erase(neighbour->mOutgoingEdges, pass);
+    }
+    for (auto* neighbour : pass->mOutgoingEdges)
+    {
+        std::erase(neighbour->mIncomingEdges, pass);
+    }
+
+    releaseSlot(mPassSlots, mFreePassSlots, pass->handle.index);
     std::erase_if(mVertices, [pass](const std::unique_ptr<Pass>& p) {
         return p->getId() == pass->getId();
     });
@@ -31,6 +79,14 @@ bool RenderGraph::deletePass(const Id_t passId)
     return true;
 }
 
+void RenderGraph::reserve(const size_t passCount, const size_t edgeCount)
+{
+    mVertices.reserve(passCount);
+    mPassSlots.reserve(passCount);
+    mEdges.reserve(edgeCount);
+    mEdgeSlots.reserve(edgeCount);
+}
+
 bool RenderGraph::insertEdge(Pass* src, const std::string& srcRes, Pass* dst, const std::string& dstRes)
 {
     if (src->mId == dst->mId) { return false; }
@@ -41,12 +97,30 @@ bool RenderGraph::insertEdge(Pass* src, const std::string& srcRes, Pass* dst, co
     auto* pDstRes = dst->getResource(dstRes);
     if (!pDstRes) { return false; }
 
+    return insertEdge(src, pSrcRes, dst, pDstRes);
+}
+
+bool RenderGraph::insertEdge(Pass* src, Resource* pSrcRes, Pass* dst, Resource* pDstRes)
+{
+    return insertEdge(src->getResourceHandle(pSrcRes), dst->getResourceHandle(pDstRes)).isValid();
+}
+
+RGEdgeHandle RenderGraph::insertEdge(const RGResourceHandle srcRes, const RGResourceHandle dstRes)
+{
+    Pass* src = getPass(srcRes.pass);
+    Pass* dst = getPass(dstRes.pass);
+    if (!src || !dst || src->mId == dst->mId || !getResource(srcRes) || !getResource(dstRes)) { return {}; }
+
     src->mOutgoingEdges.push_back(dst);
     dst->mIncomingEdges.push_back(src);
 
-    mEdges.emplace_back(IdSequence::next(), src,dst, pSrcRes, pDstRes);
+    const uint32_t slotIdx = acquireSlot(mEdgeSlots, mFreeEdgeSlots);
+    mEdgeSlots[slotIdx].edgeIdx = static_cast<uint32_t>(mEdges.size());
 
-    return true;
+    const RGEdgeHandle handle = { .index = slotIdx, .generation = mEdgeSlots[slotIdx].generation };
+    mEdges.emplace_back(IdSequence::next(), src, dst, srcRes, dstRes, handle);
+
+    return handle;
 }
 
 bool RenderGraph::deleteEdge(Pass* src, const std::string& srcRes, Pass* dst, const std::string& dstRes)
@@ -56,32 +130,58 @@ bool RenderGraph::deleteEdge(Pass* src, const std::string& srcRes, Pass* dst, co
     const auto* pSrcRes = src->getResource(srcRes);
     if (!pSrcRes) { return false; }
 
-    const auto* pDstRes = src->getResource(dstRes);
+    const auto* pDstRes = dst->getResource(dstRes);
     if (!pDstRes) { return false; }
 
     const auto edge = std::ranges::find_if(mEdges, [&](const Edge& e) {
         return e.src->getId() == src->getId() && e.dst->getId() == dst->getId()
-               && e.pSrcRes->id  == pSrcRes->id  && e.pDstRes->id  == pDstRes->id;
+               && e.srcResource() == pSrcRes && e.dstResource() == pDstRes;
     });
     if (edge == std::end(mEdges)) { return false; }
 
-    const auto b_find = std::ranges::find_if(src->mOutgoingEdges, [&](auto& v){ return v->mId == dst->mId; });
-    if (b_find == std::end(src->mOutgoingEdges)) { return false; }
+    eraseEdge(std::distance(std::begin(mEdges), edge));
 
-    const auto a_find = std::ranges::find_if(dst->mIncomingEdges, [&](auto& v){ return v->mId == src->mId; });
-    if (a_find == std::end(dst->mIncomingEdges)) { return false; }
+    return true;
+}
 
-    mEdges.erase(edge);
+bool RenderGraph::deleteEdge(const Edge& edge)
+{
+    return deleteEdge(edge.handle);
+}
 
-    src->mOutgoingEdges.erase(b_find);
-    dst->mIncomingEdges.erase(a_find);
+bool RenderGraph::deleteEdge(const RGEdgeHandle edge)
+{
+    if (!getEdge(edge)) { return false; }
+
+    eraseEdge(mEdgeSlots[edge.index].edgeIdx);
 
     return true;
 }
 
-bool RenderGraph::deleteEdge(const Edge& edge)
+int32_t RenderGraph::deleteEdges(const std::vector<RGEdgeHandle>& edges)
 {
-    return deleteEdge(edge.src, edge.pSrcRes->name, edge.dst, edge.pDstRes->name);
+    std::vector<bool> erased(mEdgeSlots.size(), false);
+    int32_t count = 0;
+    for (const auto handle : edges)
+    {
+        if (getEdge(handle) && !erased[handle.index])
+        {
+            erased[handle.index] = true;
+            count++;
+        }
+    }
+    if (count == 0) { return 0; }
+
+    const auto isErased = [&erased](const Edge& edge) { return erased[edge.handle.index]; };
+    for (const auto& edge : mEdges | std::views::filter(isErased))
+    {
+        unlinkEdge(edge);
+        releaseSlot(mEdgeSlots, mFreeEdgeSlots, edge.handle.index);
+    }
+    std::erase_if(mEdges, isErased);
+    reindexEdgeSlots(0);
+
+    return count;
 }
 
 bool RenderGraph::containsEdge(const Pass* src, const Pass* dst) noexcept
@@ -111,32 +211,96 @@ Pass* RenderGraph::getPassById(const Id_t id) const noexcept
         : pass->get();
 }
 
-RenderGraph RenderGraph::createCopy(const RenderGraph& renderGraph rg_TRACE_PARAMS)
+Pass* RenderGraph::getPass(const RGPassHandle handle) const noexcept
+{
+    if (handle.index >= mPassSlots.size() || mPassSlots[handle.index].generation != handle.generation)
+    {
+        return nullptr;
+    }
+    return mPassSlots[handle.index].pass;
+}
+
+Resource* RenderGraph::getResource(const RGResourceHandle handle) const noexcept
 {
-    static std::set sWhitelist = { "getParallelizableTasks" };
-    rg_CALL_GUARD(file, line, callerFn, sWhitelist, "This function should only be called from RenderGraphCompiler.");
+    Pass* pass = getPass(handle.pass);
+    if (!pass || handle.resource >= pass->dependencies.size())
+    {
+        return nullptr;
+    }
+    return &pass->dependencies[handle.resource];
+}
+
+const Edge* RenderGraph::getEdge(const RGEdgeHandle handle) const noexcept
+{
+    if (handle.index >= mEdgeSlots.size() || mEdgeSlots[handle.index].generation != handle.generation)
+    {
+        return nullptr;
+    }
+    return &mEdges[mEdgeSlots[handle.index].edgeIdx];
+}
 
+RenderGraph RenderGraph::createCopy(const RenderGraph& renderGraph)
+{
     RenderGraph copyGraph;
+    copyGraph.mEdges         = renderGraph.mEdges;
+    copyGraph.mPassSlots     = renderGraph.mPassSlots;
+    copyGraph.mFreePassSlots = renderGraph.mFreePassSlots;
+    copyGraph.mEdgeSlots     = renderGraph.mEdgeSlots;
+    copyGraph.mFreeEdgeSlots = renderGraph.mFreeEdgeSlots;
 
+    copyGraph.mVertices.reserve(renderGraph.mVertices.size());
     for (const auto& node : renderGraph.mVertices)
     {
-        auto* pass = copyGraph.addPass(std::make_unique<Pass>());
-        pass->dependencies = node->dependencies;
-        pass->name         = node->name;
-        pass->mId          = node->mId;
-        pass->flags        = node->flags;
+        const auto& pass = copyGraph.mVertices.emplace_back(std::make_unique<Pass>(*node));
+        copyGraph.mPassSlots[node->handle.index].pass = pass.get();
     }
 
-    for (const auto& edge : renderGraph.mEdges)
+    // Copied pointers still point into the source graph, its passes are mapped to the copies by slot.
+    const auto remap = [&copyGraph](const Pass* pass) { return copyGraph.mPassSlots[pass->handle.index].pass; };
+    for (const auto& pass : copyGraph.mVertices)
     {
-        auto* newSrc = copyGraph.getPassById(edge.src->mId);
-        auto* newDst = copyGraph.getPassById(edge.dst->mId);
-        copyGraph.insertEdge(newSrc, edge.pSrcRes->name, newDst, edge.pDstRes->name);
+        std::ranges::transform(pass->mIncomingEdges, std::begin(pass->mIncomingEdges), remap);
+        std::ranges::transform(pass->mOutgoingEdges, std::begin(pass->mOutgoingEdges), remap);
+    }
+    for (auto& edge : copyGraph.mEdges)
+    {
+        edge.src = remap(edge.src);
+        edge.dst = remap(edge.dst);
     }
 
     return copyGraph;
 }
 
+void RenderGraph::eraseEdge(const size_t edgeIdx)
+{
+    const Edge& edge = mEdges[edgeIdx];
+    unlinkEdge(edge);
+
+    releaseSlot(mEdgeSlots, mFreeEdgeSlots, edge.handle.index);
+    mEdges.erase(std::begin(mEdges) + static_cast<std::ptrdiff_t>(edgeIdx));
+    reindexEdgeSlots(edgeIdx);
+}
+
+void RenderGraph::unlinkEdge(const Edge& edge)
+{
+    if (const auto it = std::ranges::find(edge.src->mOutgoingEdges, edge.dst); it != std::end(edge.src->mOutgoingEdges))
+    {
+        edge.src->mOutgoingEdges.erase(it);
+    }
+    if (const auto it = std::ranges::find(edge.dst->mIncomingEdges, edge.src); it != std::end(edge.dst->mIncomingEdges))
+    {
+        edge.dst->mIncomingEdges.erase(it);
+    }
+}
+
+void RenderGraph::reindexEdgeSlots(const size_t firstEdgeIdx) noexcept
+{
+    for (size_t i = firstEdgeIdx; i < mEdges.size(); i++)
+    {
+        mEdgeSlots[mEdges[i].handle.index].edgeIdx = static_cast<uint32_t>(i);
+    }
+}
+
 std::unique_ptr<RenderGraph> createExampleGraph()
 {
     auto graph = std::make_unique<RenderGraph>();
@@ -181,7 +345,8 @@ std::unique_ptr<RenderGraph> createExampleGraph2()
     Pass* beginPass     = graph->addPass(Passes::sentinelBeginPass());
     Pass* someCompute   = graph->addPass(Passes::computeExample());
     Pass* gBufferPass   = graph->addPass(Passes::graphicsGBufferPass());
-    Pass* lightingPass  = graph->addPass(Passes::graphicsLightingPass());
+    Pass* cullingPass   = graph->addPass(Passes::computeLightCulling());
+    Pass* lightingPass  = graph->addPass(Passes::graphicsTiledLightingPass());
     Pass* aoPass        = graph->addPass(Passes::computeAmbientOcclusion());
     Pass* compPass      = graph->addPass(Passes::utilCompositionPass());
     Pass* aaPass        = graph->addPass(Passes::graphicsAntiAliasingPass());
@@ -199,6 +364,10 @@ std::unique_ptr<RenderGraph> createExampleGraph2()
         graph->insertEdge(gBufferPass, "normalImage", lightingPass, "normalImage"),
         graph->insertEdge(gBufferPass, "albedoImage", lightingPass, "albedoImage"),
 
+        graph->insertEdge(gBufferPass, "positionImage", cullingPass, "positionImage"),
+        graph->insertEdge(cullingPass, "lightGrid", lightingPass, "lightGrid"),
+        graph->insertEdge(cullingPass, "lightIndexList", lightingPass, "lightIndexList"),
+
         graph->insertEdge(gBufferPass, "positionImage", aoPass, "positionImage"),
         graph->insertEdge(gBufferPass, "normalImage", aoPass, "normalImage"),
 
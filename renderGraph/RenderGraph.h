@@ -18,11 +18,30 @@ public:
     /** Delete a specific Pass by id. */
     bool deletePass(Id_t passId);
 
+    /** Reserve storage for the given number of passes and edges. */
+    void reserve(size_t passCount, size_t edgeCount);
+
+    /**
+     * Create a 1-1 copy of the specified RenderGraph, IDs and handles of the source graph are valid for the copy.
+     * Slot tables, edges and passes are copied as they are, only pass pointers are remapped by slot.
+     */
+    static RenderGraph createCopy(const RenderGraph& renderGraph);
+
     /** Insert an edge between pass resources.
      * @return Success value
      */
     bool insertEdge(Pass* src, const std::string& srcRes, Pass* dst, const std::string& dstRes);
 
+    /** Insert an edge between resources of the given passes, without looking them up by name.
+     * @return Success value
+     */
+    bool insertEdge(Pass* src, Resource* srcRes, Pass* dst, Resource* dstRes);
+
+    /** Insert an edge between two resources of different passes.
+     * @return Handle of the new edge, invalid if a handle is stale or both resources belong to the same pass.
+     */
+    RGEdgeHandle insertEdge(RGResourceHandle srcRes, RGResourceHandle dstRes);
+
     /** Delete an edge between pass resources.
      * @return Success value
      */
@@ -33,6 +52,16 @@ public:
      */
     bool deleteEdge(const Edge& edge);
 
+    /** Delete an edge by handle.
+     * @return Success value
+     */
+    bool deleteEdge(RGEdgeHandle edge);
+
+    /** Delete multiple edges by handle in one pass over the edge list, stale handles are skipped.
+     * @return Number of deleted edges
+     */
+    int32_t deleteEdges(const std::vector<RGEdgeHandle>& edges);
+
     /** Check whether a specific directed edge exists.
      * @return Success value
      */
@@ -51,6 +80,11 @@ public:
     // =======================================
     Pass* getPassById(Id_t id) const noexcept;
 
+    /** Checked handle lookups, @return nullptr if the handle is invalid or the object was deleted. */
+    Pass*       getPass(RGPassHandle handle) const noexcept;
+    Resource*   getResource(RGResourceHandle handle) const noexcept;
+    const Edge* getEdge(RGEdgeHandle handle) const noexcept;
+
     const std::vector<PassPtr>& getVertices() const { return mVertices; }
     const std::vector<Edge>&    getEdges()    const { return mEdges;    }
 
@@ -60,14 +94,34 @@ private:
     friend class RenderGraphExport;
     friend class RenderGraphCompilerExport;
 
-    /**
-     * Create a 1-1 copy of the specified RenderGraph
-     * (Warning: IDs are also copied, this should be used when a 1-1 copy of the graph is required!)
-     */
-    static RenderGraph createCopy(const RenderGraph& renderGraph rg_DECL_TRACE_PARAMS);
+    /** Erase the edge at <edgeIdx> of mEdges and release its slot. */
+    void eraseEdge(size_t edgeIdx);
+
+    /** Remove the edge from the adjacency lists of its passes. */
+    static void unlinkEdge(const Edge& edge);
+
+    /** Point the edge slots at their edge again after edges at or past <firstEdgeIdx> have moved. */
+    void reindexEdgeSlots(size_t firstEdgeIdx) noexcept;
+
+    struct PassSlot
+    {
+        Pass*    pass       = nullptr;
+        uint32_t generation = 0;
+    };
+
+    struct EdgeSlot
+    {
+        uint32_t edgeIdx    = UINT32_MAX;   // Index into mEdges
+        uint32_t generation = 0;
+    };
+
+    std::vector<PassPtr>  mVertices;
+    std::vector<Edge>     mEdges;
 
-    std::vector<PassPtr> mVertices;
-    std::vector<Edge>    mEdges;
+    std::vector<PassSlot> mPassSlots;
+    std::vector<uint32_t> mFreePassSlots;
+    std::vector<EdgeSlot> mEdgeSlots;
+    std::vector<uint32_t> mFreeEdgeSlots;
 };
 
 std::unique_ptr<RenderGraph> createExampleGraph();
@@ -0,0 +1,114 @@
+#include "RenderGraphBuilder.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "IdSequence.h"
+#include "RenderGraph.h"
+
+RenderGraphBuilder::RenderGraphBuilder()
+: mRenderGraph(std::make_unique<RenderGraph>())
+{
+}
+
+RenderGraphBuilder::~RenderGraphBuilder() = default;
+
+RGPassHandle RenderGraphBuilder::addPass(std::string name, const PassFlags& flags)
+{
+    auto pass = std::make_unique<Pass>();
+    pass->mId   = IdSequence::next();
+    pass->name  = std::move(name);
+    pass->flags = flags;
+    return addPass(std::move(pass));
+}
+
+RGPassHandle RenderGraphBuilder::addPass(PassPtr&& pass)
+{
+    return mRenderGraph->addPass(std::move(pass))->handle;
+}
+
+RGResourceHandle RenderGraphBuilder::addResource(
+    const RGPassHandle   pass,
+    std::string          name,
+    const ResourceType   type,
+    const AccessType     access,
+    const ResourceFlags& flags,
+    const ResourceDesc&  desc)
+{
+    Pass* target = mRenderGraph->getPass(pass);
+    if (!target)
+    {
+        return {};
+    }
+
+    auto& dependencies = target->dependencies;
+    dependencies.push_back({
+        .id     = IdSequence::next(),
+        .name   = std::move(name),
+        .type   = type,
+        .access = access,
+        .flags  = flags,
+        .desc   = desc,
+    });
+    return { .pass = pass, .resource = static_cast<uint32_t>(dependencies.size() - 1) };
+}
+
+std::optional<RGResourceHandle> RenderGraphBuilder::getResource(const RGPassHandle pass, const std::string_view name) const
+{
+    const Pass* target = mRenderGraph->getPass(pass);
+    if (!target)
+    {
+        return std::nullopt;
+    }
+
+    const auto& dependencies = target->dependencies;
+    const auto it = std::ranges::find(dependencies, name, &Resource::name);
+    if (it == std::end(dependencies))
+    {
+        return std::nullopt;
+    }
+    return RGResourceHandle { .pass = pass, .resource = static_cast<uint32_t>(std::distance(std::begin(dependencies), it)) };
+}
+
+bool RenderGraphBuilder::connect(const RGResourceHandle src, const RGResourceHandle dst)
+{
+    if (!isValid(src) || !isValid(dst) || src.pass == dst.pass)
+    {
+        return false;
+    }
+
+    mEdges.push_back({ .src = src, .dst = dst });
+    return true;
+}
+
+bool RenderGraphBuilder::connect(const std::span<const RGEdgeDesc> edges)
+{
+    const bool valid = std::ranges::all_of(edges, [this](const RGEdgeDesc& edge) {
+        return isValid(edge.src) && isValid(edge.dst) && edge.src.pass != edge.dst.pass;
+    });
+    if (!valid)
+    {
+        return false;
+    }
+
+    mEdges.reserve(mEdges.size() + edges.size());
+    mEdges.append_range(edges);
+    return true;
+}
+
+std::unique_ptr<RenderGraph> RenderGraphBuilder::build()
+{
+    mRenderGraph->reserve(mRenderGraph->getVertices().size(), mEdges.size());
+    for (const auto& [src, dst] : mEdges)
+    {
+        mRenderGraph->insertEdge(src, dst);
+    }
+
+    mEdges.clear();
+    return std::exchange(mRenderGraph, std::make_unique<RenderGraph>());
+}
+
+bool RenderGraphBuilder::isValid(const RGResourceHandle handle) const noexcept
+{
+    return mRenderGraph->getResource(handle) != nullptr;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "RenderGraphCore.h"
+
+class RenderGraph;
+
+// =======================================
+// Render Graph Builder : Types
+// =======================================
+struct RGEdgeDesc
+{
+    RGResourceHandle src;
+    RGResourceHandle dst;
+};
+
+// =======================================
+// Render Graph Builder
+// =======================================
+
+/**
+ * Builds a RenderGraph from handles instead of names.
+ * Declaring a pass or resource returns its handle, which stays valid for the built graph.
+ * Edges are validated by handle in O(1) and inserted by build(), once every resource is declared.
+ */
+class RenderGraphBuilder
+{
+public:
+    RenderGraphBuilder();
+    ~RenderGraphBuilder();
+
+    RGPassHandle addPass(std::string name, const PassFlags& flags);
+
+    /** Add a pass created by one of the Passes:: factories, including its resources. */
+    RGPassHandle addPass(PassPtr&& pass);
+
+    RGResourceHandle addResource(RGPassHandle pass, std::string name, ResourceType type, AccessType access, const ResourceFlags& flags = {}, const ResourceDesc& desc = {});
+
+    /** @return Handle of a resource declared by name, e.g. by a factory, std::nullopt if the pass has none. */
+    std::optional<RGResourceHandle> getResource(RGPassHandle pass, std::string_view name) const;
+
+    /** @return False if a handle is invalid or both resources belong to the same pass. */
+    bool connect(RGResourceHandle src, RGResourceHandle dst);
+
+    /** Connect all edges, storage is reserved once. @return False if any edge is invalid, none are added then. */
+    bool connect(std::span<const RGEdgeDesc> edges);
+
+    /** Insert the edges and hand over the graph, the builder is empty afterward. */
+    std::unique_ptr<RenderGraph> build();
+
+private:
+    bool isValid(RGResourceHandle handle) const noexcept;
+
+    std::unique_ptr<RenderGraph> mRenderGraph;
+    std::vector<RGEdgeDesc>      mEdges;
+};
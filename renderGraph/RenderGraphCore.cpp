@@ -7,7 +7,7 @@ Resource* Pass::getResource(const std::string& resourceName)
     const auto it = std::ranges::find_if(dependencies, [&resourceName](const Resource& resource) {
         return resource.name == resourceName;
     });
-    return &(*it);
+    return it == std::end(dependencies) ? nullptr : &(*it);
 }
 
 Resource* Pass::getResource(const Id_t resourceId)
@@ -15,5 +15,17 @@ Resource* Pass::getResource(const Id_t resourceId)
     const auto it = std::ranges::find_if(dependencies, [&resourceId](const Resource& resource) {
         return resource.id == resourceId;
     });
-    return &(*it);
+    return it == std::end(dependencies) ? nullptr : &(*it);
+}
+
+RGResourceHandle Pass::getResourceHandle(const Resource* resource) const noexcept
+{
+    for (uint32_t i = 0; i < dependencies.size(); i++)
+    {
+        if (&dependencies[i] == resource)
+        {
+            return { .pass = handle, .resource = i };
+        }
+    }
+    return {};
 }
@@ -1,46 +1,21 @@
 #pragma once
 
+#include <compare>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include "Graph.h"
+#include "RGHandle.h"
 
 #ifdef rg_JSON_EXPORT
     #include <nlohmann/json.hpp>
 #endif
 
 
-// =======================================
-// Render Graph : Macros
-// =======================================
-#define rg_TRACE
-
-// The following macros are for debugging / validation purposes.
-#ifdef rg_TRACE
-    // Declare trace parameters in a function declaration
-    #define rg_DECL_TRACE_PARAMS , const char* file = __builtin_FILE(), int line = __builtin_LINE(), const char* callerFn = __builtin_FUNCTION()
-
-    // Declare trace parameters for a function implementation
-    #define rg_TRACE_PARAMS , const char* file, int line, const char* callerFn
-
-    // Assert that a function was called from one that is allowed to call it.
-    #define rg_CALL_GUARD(file, line, callerFn, whitelist, message) \
-        if (!whitelist.contains(callerFn)) \
-        { \
-            const std::filesystem::path path {file}; \
-            std::println("!!! Function {} was called from {} (file: {}, line: {}) : {}", \
-                __builtin_FUNCTION(), callerFn, path.filename().c_str(), line, message); \
-            exit(EXIT_FAILURE); \
-        }
-#else
-    #define rg_DECL_TRACE_PARAMS
-    #define rg_TRACE_PARAMS
-    #define rg_CALL_GUARD(file, line, callerFn, whitelist, message)
-#endif
-
 // =======================================
 // Render Graph : Forward Decl., Constants
 // =======================================
@@ -131,6 +106,22 @@ struct ResourceFlags
     bool dontOptimize = false;  // Don't consider this resource during Resource Optimization phase.
 };
 
+/** Image properties which must match for two images to alias the same physical image. */
+struct ResourceCompatibilityKey
+{
+    uint32_t format  = 0;       // Backend format value, 0 if unknown.
+    uint32_t usage   = 0;       // Backend usage flag bits.
+    uint32_t samples = 1;
+
+    auto operator<=>(const ResourceCompatibilityKey&) const = default;
+};
+
+struct ResourceDesc
+{
+    uint64_t                 size = 0;      // Size in bytes, 0 if unknown.
+    ResourceCompatibilityKey compatibility;
+};
+
 /**
  * (1) "Resource" can now be simple as this, as the exact specifications are only required for
  * pass-specific resource allocation, as Images are now memory aliased.
@@ -146,6 +137,17 @@ struct Resource
     ResourceType    type;
     AccessType      access;
     ResourceFlags   flags;
+    ResourceDesc    desc;
+};
+
+/** Packed PassFlags, one bit per flag. */
+enum RGPassFlagBits : uint8_t
+{
+    RGPassFlag_Raster    = 1 << 0,
+    RGPassFlag_Compute   = 1 << 1,
+    RGPassFlag_Async     = 1 << 2,
+    RGPassFlag_NeverCull = 1 << 3,
+    RGPassFlag_Sentinel  = 1 << 4,
 };
 
 struct PassFlags
@@ -155,21 +157,47 @@ struct PassFlags
     bool async      = false;    // Async Pass
     bool neverCull  = false;    // Don't allow the culling of the pass
     bool sentinel   = false;    // Begin / Present "Pass"
+
+    constexpr uint8_t bits() const noexcept
+    {
+        return (raster    ? RGPassFlag_Raster    : 0)
+             | (compute   ? RGPassFlag_Compute   : 0)
+             | (async     ? RGPassFlag_Async     : 0)
+             | (neverCull ? RGPassFlag_NeverCull : 0)
+             | (sentinel  ? RGPassFlag_Sentinel  : 0);
+    }
+
+    static constexpr PassFlags fromBits(const uint8_t bits) noexcept
+    {
+        return {
+            .raster    = (bits & RGPassFlag_Raster) != 0,
+            .compute   = (bits & RGPassFlag_Compute) != 0,
+            .async     = (bits & RGPassFlag_Async) != 0,
+            .neverCull = (bits & RGPassFlag_NeverCull) != 0,
+            .sentinel  = (bits & RGPassFlag_Sentinel) != 0,
+        };
+    }
 };
 
-struct Pass final : Vertex
+struct Pass final : Vertex<Pass>
 {
-    ~Pass() override = default;
-
     Id_t getId() const { return mId; }
 
+    /** @return Resource of the pass with the given name, nullptr if there is none. */
     Resource* getResource(const std::string& resourceName);
 
+    /** @return Resource of the pass with the given ID, nullptr if there is none. */
     Resource* getResource(Id_t resourceId);
 
+    /** @return Handle of the given resource of this pass, an invalid handle if it is not one of its resources. */
+    RGResourceHandle getResourceHandle(const Resource* resource) const noexcept;
+
     std::string             name;
     PassFlags               flags;
     std::vector<Resource>   dependencies;
+    RGPassHandle            handle;     // Assigned by RenderGraph::addPass
+
+    std::function<void(const Pass&)> execute;   // Invoked by the RGExecutor, optional
 };
 
 // =======================================
@@ -181,11 +209,30 @@ struct RGTask
     Pass* asyncPass;
 };
 
+/**
+ * Resources are referenced by handle rather than by pointer, they stay valid if the resources of a pass
+ * are reallocated and an Edge can be copied verbatim into a copy of the graph.
+ * srcResource() / dstResource() return nullptr if the handle doesn't belong to <src> / <dst> or is out of range.
+ */
 struct Edge
 {
-    Id_t        id;
-    Pass*       src;
-    Pass*       dst;
-    Resource*   pSrcRes = nullptr;
-    Resource*   pDstRes = nullptr;
+    Id_t                id;
+    Pass*               src;
+    Pass*               dst;
+    RGResourceHandle    srcRes;
+    RGResourceHandle    dstRes;
+    RGEdgeHandle        handle;
+
+    Resource* srcResource() const noexcept { return resolve(src, srcRes); }
+    Resource* dstResource() const noexcept { return resolve(dst, dstRes); }
+
+private:
+    static Resource* resolve(Pass* pass, const RGResourceHandle res) noexcept
+    {
+        if (res.pass != pass->handle || res.resource >= pass->dependencies.size())
+        {
+            return nullptr;
+        }
+        return &pass->dependencies[res.resource];
+    }
 };
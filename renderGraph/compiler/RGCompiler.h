@@ -3,12 +3,16 @@
 #include <expected>
 #include <optional>
 #include <ranges>
+#include <set>
 
 #include "../RenderGraph.h"
+#include "../RGPassTable.h"
 #include "../export/RenderGraphExport.h"
 #include "../export/RGCompilerExport.h"
 
 #include "RGCompilerTypes.h"
+#include "RGMemoryOrder.h"
+#include "RGPlanCache.h"
 #include "RGResourceOpt.h"
 
 // =======================================
@@ -29,24 +33,70 @@ public:
     {
     }
 
+    /**
+     * Execution plan of the graph from the on-disk plan cache, mapped without parsing.
+     * @return std::nullopt if the cache is disabled or holds no valid plan for the graph and options.
+     */
+    std::optional<RGCachedPlan> loadCachedPlan() const
+    {
+        if (mOptions.planCacheDirectory.empty())
+        {
+            return std::nullopt;
+        }
+        return RGPlanCache(mOptions.planCacheDirectory).load(*mRenderGraph, mOptions);
+    }
+
+    /**
+     * Store the execution plan of a compiler output in the plan cache, for loadCachedPlan() on the next run.
+     * Failing to write the cache is not a compiler error, the graph is simply compiled again.
+     * @return Whether the cache is enabled and the plan was written.
+     */
+    bool storeCachedPlan(const RGCompilerOutput& output) const
+    {
+        if (mOptions.planCacheDirectory.empty() || output.hasFailed)
+        {
+            return false;
+        }
+        return RGPlanCache(mOptions.planCacheDirectory).store(*mRenderGraph, mOptions, output.executionPlan);
+    }
+
     RGCompilerOutput compile() const
     {
+        const RGPassTable passTable(*mRenderGraph);
+
         // Preamble Phase
-        const auto cullNodesResult = cullNodes();
+        const auto cullNodesResult = cullNodes(passTable);
         rg_CHECK_COMPILER_STEP_RESULT(cullNodesResult);
 
         // Task Scheduling Phase
         const auto serialExecutionOrderResult = getSerialExecutionOrder(cullNodesResult.value());
         rg_CHECK_COMPILER_STEP_RESULT(serialExecutionOrderResult);
 
-        auto parallelizableTasksResult = getParallelizableTasks(serialExecutionOrderResult.value());
+        const auto memoryOrderingResult = getMemoryAwareOrder(serialExecutionOrderResult.value());
+        rg_CHECK_COMPILER_STEP_RESULT(memoryOrderingResult);
+
+        const auto& executionOrder = memoryOrderingResult->order;
+
+        const auto transitiveReductionResult = getTransitiveReduction(cullNodesResult.value());
+        rg_CHECK_COMPILER_STEP_RESULT(transitiveReductionResult);
+
+        auto parallelizableTasksResult = getParallelizableTasks(executionOrder, transitiveReductionResult.value(), passTable);
         rg_CHECK_COMPILER_STEP_RESULT(parallelizableTasksResult);
 
-        const auto finalTaskOrderResult = getFinalTaskOrder(serialExecutionOrderResult.value(), parallelizableTasksResult.value());
+        const auto finalTaskOrderResult = getFinalTaskOrder(executionOrder, parallelizableTasksResult.value(), passTable);
         rg_CHECK_COMPILER_STEP_RESULT(finalTaskOrderResult);
 
+        const auto framePipelineResult = getFramePipeline(finalTaskOrderResult.value(), passTable);
+        rg_CHECK_COMPILER_STEP_RESULT(framePipelineResult);
+
+        const auto queueSyncResult = getQueueSyncPlan(finalTaskOrderResult.value(), transitiveReductionResult->edges);
+        rg_CHECK_COMPILER_STEP_RESULT(queueSyncResult);
+
+        const auto wavefrontsResult = getWavefronts(executionOrder, transitiveReductionResult->edges);
+        rg_CHECK_COMPILER_STEP_RESULT(wavefrontsResult);
+
          // Resource Optimizing Phase
-        const auto resourceOptimizerResult = optimizeResources(finalTaskOrderResult.value());
+        const auto resourceOptimizerResult = optimizeResources(finalTaskOrderResult.value(), framePipelineResult.value());
         rg_CHECK_COMPILER_STEP_RESULT(resourceOptimizerResult);
 
         // Create Templates
@@ -59,16 +109,28 @@ public:
             .failReason         = RGCompilerError::None,
             .phaseOutputs       = RGCompilerPhaseOutputs {
                 .cullNodes              = cullNodesResult.value(),
-                .serialExecutionOrder   = serialExecutionOrderResult.value(),
+                .serialExecutionOrder   = executionOrder,
+                .orderingStats          = RGOrderingStats {
+                    .peakLiveBefore = memoryOrderingResult->peakLiveBefore,
+                    .peakLiveAfter  = memoryOrderingResult->peakLiveAfter,
+                },
+                .transitiveReduction    = transitiveReductionResult->edges,
                 .parallelizableNodes    = parallelizableTasksResult.value(),
                 .taskOrder              = finalTaskOrderResult.value(),
+                .framePipeline          = framePipelineResult.value(),
+                .queueSync              = queueSyncResult.value(),
+                .wavefronts             = wavefrontsResult.value(),
                 .resourceOptimizer      = resourceOptimizerResult.value(),
             },
             .options = mOptions,
         };
 
+        // Lower for Execution
+        output.executionPlan = getExecutionPlan(output);
+
         // Export Visualization & Debug Data
         RenderGraphExport::exportMermaid(mRenderGraph);
+        RenderGraphExport::exportGraphvizDOT(mRenderGraph, output.phaseOutputs->transitiveReduction);
         RenderGraphCompilerExport::exportMermaidCompilerOutput(output);
         RenderGraphCompilerExport::exportJSONCompilerOutput(output, mRenderGraph);
 
@@ -82,23 +144,30 @@ private:
 
     /** Render Graph Compiler : Step 1
      * Cull unreachable nodes from the Render Graph unless they are flagged as "neverCull".
+     * @param passTable Pass table of the Render Graph.
      * @return List of Node IDs that remain after culling.
      */
-    RGCompilerResult<std::vector<Id_t>> cullNodes() const noexcept
+    RGCompilerResult<std::vector<Id_t>> cullNodes(const RGPassTable& passTable) const noexcept
     {
-        const auto rootNode = getRootNode(*mRenderGraph);
+        const auto rootNode = getRootNode(passTable);
         if (!rootNode.has_value())
         {
             return std::unexpected(rootNode.error());
         }
 
-        std::set<Id_t> remainingNodes = mRenderGraph->mVertices
-            | std::views::filter([](const auto& pass){ return pass->flags.neverCull; })
-            | std::views::transform([](const auto& pass){ return pass->mId; })
+        std::set<Id_t> remainingNodes = passTable.select(RGPassFlag_NeverCull)
+            | std::views::transform([&passTable](const uint32_t slot){ return passTable.id(slot); })
             | std::ranges::to<std::set<Id_t>>();
 
-        const std::set<Id_t> reachableNodes = BFS::execute(rootNode.value());
-        remainingNodes.insert_range(reachableNodes);
+        const auto passes = mRenderGraph->mVertices
+            | std::views::transform([](const PassPtr& pass){ return pass.get(); })
+            | std::ranges::to<std::vector<Pass*>>();
+        const VertexListGraph graph(passes);
+
+        for (const uint32_t reachable : BFS::execute(graph, graph.indexOf(rootNode.value())))
+        {
+            remainingNodes.insert(graph.vertex(reachable)->mId);
+        }
 
         return std::ranges::to<std::vector<Id_t>>(remainingNodes);
     }
@@ -113,83 +182,106 @@ private:
      */
     RGCompilerResult<std::vector<Id_t>> getSerialExecutionOrder(const std::vector<Id_t>& nodeIds) const noexcept
     {
-        const auto nodePtrs = mRenderGraph->toNodePtrList(nodeIds) | std::ranges::to<std::vector<Vertex*>>();
+        const auto nodePtrs = mRenderGraph->toNodePtrList(nodeIds);
+        const VertexListGraph graph(nodePtrs);
 
-        const auto tsortResult = TopologicalSort::execute(nodePtrs);
+        const auto tsortResult = TopologicalSort::execute(graph);
         if (!tsortResult.has_value())
         {
             return std::unexpected(RGCompilerError::CyclicDependency);
         }
 
-        return tsortResult.value();
+        return tsortResult.value()
+            | std::views::transform([&graph](const uint32_t v){ return graph.vertex(v)->mId; })
+            | std::ranges::to<std::vector<Id_t>>();
     }
 
     /** Render Graph Compiler : Step 2.2
-     * Find parallelizable tasks in the Render Graphs.
+     * Reorder the serial execution order to minimize the peak of simultaneously live resources.
+     * Ready passes are picked greedily, each candidate is scored by the best peak reachable within the lookahead.
+     * At each lookahead step only the ready passes leaving the fewest live resources are explored, up to the candidate limit.
      * @param nodeIds List of node IDs in serial execution order.
-     * @return Node ID -> List of Node IDs that can run in parallel with the key.
+     * @return Reordered node IDs with the peak live resource count before and after, the input order if reordering
+     * doesn't lower the peak and without stats if disabled.
      */
-    RGCompilerResult<std::map<Id_t, std::vector<Id_t>>> getParallelizableTasks(const std::vector<Id_t>& nodeIds) const noexcept
+    RGCompilerResult<RGMemoryOrdering> getMemoryAwareOrder(const std::vector<Id_t>& nodeIds) const
     {
-        std::map<Id_t, std::vector<Id_t>> canRunInParallel;
-
-        // Create shadow graph without multi edges between nodes
-        std::vector<Edge> duplicateEdges;
-        for (const auto& edge : mRenderGraph->mEdges)
+        if (!mOptions.memoryAwareOrdering)
         {
-            const auto duplicated = mRenderGraph->mEdges
-                | std::views::filter([&edge](const Edge& e) {
-                    return edge.id != e.id
-                        && edge.src->mId == e.src->mId
-                        && edge.dst->mId == e.src->mId;
-                })
-                | std::ranges::to<std::vector<Edge>>();
-            duplicateEdges.append_range(duplicated);
+            return RGMemoryOrdering { .order = nodeIds };
         }
 
-        RenderGraph shadowGraph = RenderGraph::createCopy(*mRenderGraph);
-        for (const auto& edge : duplicateEdges)
+        const RGMemoryAwareOrder ordering(mRenderGraph, nodeIds);
+        return ordering.execute(mOptions.orderingLookahead, mOptions.orderingCandidates);
+    }
+
+    /** Render Graph Compiler : Step 2.3
+     * Get the minimal set of dependency edges between the remaining nodes.
+     * @return (src, dst) Node ID pairs of the transitive reduction, and the reachability between the remaining nodes.
+     */
+    RGCompilerResult<RGTransitiveReduction> getTransitiveReduction(const std::vector<Id_t>& nodeIds) const noexcept
+    {
+        const auto nodePtrs = mRenderGraph->toNodePtrList(nodeIds);
+        const VertexListGraph graph(nodePtrs);
+
+        auto reductionResult = TransitiveReduction::execute(graph);
+        if (!reductionResult.has_value())
         {
-            shadowGraph.deleteEdge(edge);
+            return std::unexpected(RGCompilerError::CyclicDependency);
         }
 
-        // Propagate dependencies with new edges
-        for (auto& node : shadowGraph.mVertices)
+        RGTransitiveReduction reduction;
+        reduction.edges = reductionResult->edges
+            | std::views::transform([&graph](const auto& edge) {
+                return std::pair(graph.vertex(edge.first)->mId, graph.vertex(edge.second)->mId);
+            })
+            | std::ranges::to<std::vector<std::pair<Id_t, Id_t>>>();
+        for (const auto& [i, node] : std::views::enumerate(nodePtrs))
         {
-            for (auto& dst : shadowGraph.mVertices)
-            {
-                if (node->mId != dst->mId && BFS::hasPath(node.get(), dst.get()))
-                {
-                    shadowGraph.insertEdge(node.get(), node->dependencies[0].name, dst.get(), dst->dependencies[0].name);
-                }
-            }
+            reduction.vertexOf.emplace(node->mId, static_cast<uint32_t>(i));
         }
+        reduction.reachability = std::move(reductionResult->reachability);
 
-        // RenderGraphExport::exportMermaid(mRenderGraph);
-        // RenderGraphExport::exportMermaid(&shadowGraph);
+        return reduction;
+    }
 
-        // Shadow Graph nodes in Serial execution order.
-        const auto shadowNodes = nodeIds
-            | std::views::transform([&](const int32_t id){ return shadowGraph.getPassById(id); })
-            | std::ranges::to<std::vector<Pass*>>();
+    /** Render Graph Compiler : Step 2.4
+     * Find parallelizable tasks in the Render Graphs.
+     * @param nodeIds List of node IDs in serial execution order.
+     * @param transitiveReduction Reachability between the nodes, two nodes can't run in parallel if either one reaches the other.
+     * @param passTable Pass table of the Render Graph.
+     * @return Node ID -> List of Node IDs that can run in parallel with the key.
+     */
+    RGCompilerResult<std::map<Id_t, std::vector<Id_t>>> getParallelizableTasks(
+        const std::vector<Id_t>&     nodeIds,
+        const RGTransitiveReduction& transitiveReduction,
+        const RGPassTable&           passTable) const noexcept
+    {
+        std::map<Id_t, std::vector<Id_t>> canRunInParallel;
+
+        // Sentinel flags are tested by slot, the passes themselves are never touched.
+        const auto sentinels  = passTable.selectSet(RGPassFlag_Sentinel);
+        const auto isSentinel = nodeIds
+            | std::views::transform([&](const Id_t nodeId){ return sentinels.contains(passTable.slotOf(nodeId)); })
+            | std::ranges::to<std::vector<bool>>();
 
         // Find parallelizable nodes
-        for (const auto& [i, node] : std::views::enumerate(shadowNodes))
+        for (const auto& [i, nodeId] : std::views::enumerate(nodeIds))
         {
-            if (node->flags.sentinel) continue; /* Ignore sentinel pass */
+            if (isSentinel[i]) continue; /* Ignore sentinel pass */
 
             std::vector<Id_t> independentNodes;
-            for (const auto& [j, other] : std::views::enumerate(shadowNodes))
+            for (const auto& [j, otherId] : std::views::enumerate(nodeIds))
             {
-                if (node->mId == other->mId                         /* Ignore self */
-                    || other->flags.sentinel                        /* Ignore sentinel pass */
-                    || i > j                                        /* if Other precedes Node ignore */
-                    || shadowGraph.containsAnyEdge(node, other) /* if any edge between Node and Other ignore */
+                if (nodeId == otherId                                   /* Ignore self */
+                    || isSentinel[j]                                    /* Ignore sentinel pass */
+                    || i > j                                            /* if Other precedes Node ignore */
+                    || transitiveReduction.isOrdered(nodeId, otherId)   /* if any path between Node and Other ignore */
                 ) continue;
-                independentNodes.push_back(other->mId);
+                independentNodes.push_back(otherId);
             }
 
-            canRunInParallel[node->mId] = independentNodes;
+            canRunInParallel[nodeId] = independentNodes;
         }
 
         // Remove empty entries
@@ -204,15 +296,17 @@ private:
         return canRunInParallel;
     }
 
-    /** Render Graph Compiler : Step 2.3
+    /** Render Graph Compiler : Step 2.5
      * Create final tasks based on serial execution order and parallelizable tasks.
      * @param serialExecutionOrder List of node IDs in serial execution order.
      * @param parallelizableTasks Map of Node ID -> List of Node IDs that can run in parallel with the key.
+     * @param passTable Pass table of the Render Graph.
      * @return Final list of Render Graph Tasks in execution order.
      */
     RGCompilerResult<std::vector<RGTask>> getFinalTaskOrder(
         const std::vector<Id_t>&           serialExecutionOrder,
-        std::map<Id_t, std::vector<Id_t>>& parallelizableTasks) const noexcept
+        std::map<Id_t, std::vector<Id_t>>& parallelizableTasks,
+        const RGPassTable&                 passTable) const noexcept
     {
         std::vector<RGTask> tasks;
 
@@ -233,6 +327,7 @@ private:
         }
 
         // Create parallel tasks if possible
+        const auto     asyncPasses = passTable.selectSet(RGPassFlag_Async);
         const auto     chancesForParallelization = static_cast<int32_t>(parallelizableTasks.size());
         int32_t        parallelTaskCount = 0;
         std::set<Id_t> nodesIncludedInTasks;
@@ -256,10 +351,10 @@ private:
 
             // Try to find a task to run in parallel.
             const auto parallelizableNodes = parallelizableTasks[node->mId]
-                | std::views::filter([&](const Id_t otherId){ return mRenderGraph->getPassById(otherId)->flags.async; })
+                | std::views::filter([&](const Id_t otherId){ return asyncPasses.contains(passTable.slotOf(otherId)); })
                 | std::ranges::to<std::vector<Id_t>>();
 
-            auto* selectedAsyncTask = parallelizableNodes.empty() ? nullptr : mRenderGraph->getPassById(parallelizableNodes[0]);
+            auto* selectedAsyncTask = parallelizableNodes.empty() ? nullptr : passTable.pass(passTable.slotOf(parallelizableNodes[0]));
 
             RGTask parallelTask = {
                 .pass      = node,
@@ -278,17 +373,198 @@ private:
         return tasks;
     }
 
+    /** Render Graph Compiler : Step 2.6
+     * Create the steady-state schedule for multiple frames in flight.
+     * Async passes that only depend on the Root pass are hoisted into free async slots at the tail of the
+     * previous frame, the resources they touch are duplicated for each overlapping frame.
+     * The schedule is advisory : queue synchronization, resource lifetimes and the execution plan are derived
+     * from the single frame task order, only the duplicated resources are fed back to exclude them from aliasing.
+     * @param tasks Final list of Render Graph Tasks in execution order.
+     * @param passTable Pass table of the Render Graph.
+     * @return Modulo schedule of a single frame period and the resources it requires to be duplicated.
+     */
+    RGCompilerResult<RGFramePipeline> getFramePipeline(const std::vector<RGTask>& tasks, const RGPassTable& passTable) const noexcept
+    {
+        RGFramePipeline pipeline = {
+            .framesInFlight     = std::max(mOptions.framesInFlight, 1),
+            .initiationInterval = static_cast<int32_t>(tasks.size()),
+            .steadyStateTasks   = tasks
+                | std::views::transform([](const RGTask& task){ return RGPipelinedTask { .task = task }; })
+                | std::ranges::to<std::vector<RGPipelinedTask>>(),
+        };
+
+        // Without frame overlap or async scheduling the single frame schedule is the steady state.
+        if (pipeline.framesInFlight < 2 || !mOptions.allowParallelization)
+        {
+            return pipeline;
+        }
+
+        const auto asyncPasses = passTable.selectSet(RGPassFlag_Async);
+        const auto sentinels   = passTable.selectSet(RGPassFlag_Sentinel);
+
+        // Slots of the passes with an input from a non-sentinel pass, read from the pass handles the edge resources carry.
+        std::vector<bool> hasPassInput(passTable.size(), false);
+        for (const auto& edge : mRenderGraph->mEdges)
+        {
+            if (!sentinels.contains(edge.srcRes.pass.index))
+            {
+                hasPassInput[edge.dstRes.pass.index] = true;
+            }
+        }
+
+        const auto isHoistable = [&](const Pass* pass) {
+            if (!pass)
+            {
+                return false;
+            }
+            const uint32_t slot = pass->handle.index;
+            return asyncPasses.contains(slot) && !sentinels.contains(slot) && !hasPassInput[slot];
+        };
+
+        auto& steadyTasks = pipeline.steadyStateTasks;
+        const auto taskCount = static_cast<int32_t>(steadyTasks.size());
+        for (int32_t i = 0; i < taskCount; i++)
+        {
+            for (Pass* candidate : { steadyTasks[i].task.asyncPass, steadyTasks[i].task.pass })
+            {
+                // A task holding a pass hoisted from the next frame is no origin, its async slot is taken
+                // and removing its main pass would move the hoisted pass into the current frame.
+                if (!isHoistable(candidate) || steadyTasks[i].asyncFrameOffset != 0)
+                {
+                    continue;
+                }
+
+                // Find the latest free async slot in the tail of the frame.
+                int32_t slot = -1;
+                for (int32_t j = taskCount - 1; j > i; j--)
+                {
+                    const auto& other = steadyTasks[j].task;
+                    if (other.pass && !sentinels.contains(other.pass->handle.index) && !other.asyncPass)
+                    {
+                        slot = j;
+                        break;
+                    }
+                }
+                if (slot == -1)
+                {
+                    continue;
+                }
+
+                steadyTasks[slot].task.asyncPass  = candidate;
+                steadyTasks[slot].asyncFrameOffset = 1;
+
+                // Remove the pass from its original task, an emptied task is dropped from the period.
+                auto& origin = steadyTasks[i].task;
+                if (origin.asyncPass == candidate)
+                {
+                    origin.asyncPass = nullptr;
+                }
+                else
+                {
+                    origin.pass      = origin.asyncPass;
+                    origin.asyncPass = nullptr;
+                }
+
+                pipeline.hoistedPasses.push_back(candidate->mId);
+            }
+        }
+
+        std::erase_if(steadyTasks, [](const RGPipelinedTask& task){ return task.task.pass == nullptr; });
+        pipeline.initiationInterval = static_cast<int32_t>(steadyTasks.size());
+
+        // Resources of hoisted passes are live in two frames at once.
+        const int32_t copies = std::min(pipeline.framesInFlight, 2);
+        for (const auto passId : pipeline.hoistedPasses)
+        {
+            const auto* pass = mRenderGraph->getPassById(passId);
+            for (const auto& resource : pass->dependencies)
+            {
+                if (resource.access == AccessType::Write || resource.type == ResourceType::External)
+                {
+                    pipeline.duplicatedResources.push_back({
+                        .resourceId = resource.id,
+                        .passId     = passId,
+                        .copies     = copies,
+                    });
+                }
+            }
+        }
+
+        return pipeline;
+    }
+
+    /** Render Graph Compiler : Step 2.7
+     * Plan semaphore waits and queue ownership transfers between the graphics and compute queues.
+     * @param tasks Final list of Render Graph Tasks in execution order.
+     * @param transitiveReduction Minimal dependency edges, waits are only generated for these.
+     * @return Minimal set of cross-queue waits and the required ownership transfers.
+     */
+    RGCompilerResult<RGQueueSyncPlan> getQueueSyncPlan(
+        const std::vector<RGTask>&                 tasks,
+        const std::vector<std::pair<Id_t, Id_t>>&  transitiveReduction) const noexcept
+    {
+        return RGQueueSync::generate(tasks, mRenderGraph->mEdges, transitiveReduction);
+    }
+
+    /** Render Graph Compiler : Step 2.8
+     * Group the passes into topological levels for concurrent command recording.
+     * The level of a pass is the length of the longest dependency path leading to it,
+     * the transitive reduction has the same longest paths with fewer edges.
+     * @param serialExecutionOrder List of node IDs in serial execution order.
+     * @param transitiveReduction Minimal dependency edges between the nodes.
+     * @return Levels in submission order and the level of each pass.
+     */
+    RGCompilerResult<RGWavefronts> getWavefronts(
+        const std::vector<Id_t>&                   serialExecutionOrder,
+        const std::vector<std::pair<Id_t, Id_t>>&  transitiveReduction) const noexcept
+    {
+        std::map<Id_t, std::vector<Id_t>> predecessors;
+        for (const auto& [src, dst] : transitiveReduction)
+        {
+            predecessors[dst].push_back(src);
+        }
+
+        RGWavefronts wavefronts;
+        for (const auto passId : serialExecutionOrder)
+        {
+            int32_t level = 0;
+            for (const auto predecessor : predecessors[passId])
+            {
+                const auto it = wavefronts.levelOf.find(predecessor);
+                if (it == std::end(wavefronts.levelOf))
+                {
+                    return std::unexpected(RGCompilerError::CyclicDependency);
+                }
+                level = std::max(level, it->second + 1);
+            }
+
+            wavefronts.levelOf.emplace(passId, level);
+            if (level == static_cast<int32_t>(wavefronts.levels.size()))
+            {
+                wavefronts.levels.emplace_back();
+            }
+            wavefronts.levels[level].push_back(passId);
+        }
+
+        return wavefronts;
+    }
+
     // =======================================
     // Render Graph Compiler Phase : Resources
     // =======================================
 
     /** Render Graph Compiler : Step 3.1
      * Run the resource optimization algorithm.
+     * Resources duplicated by frame pipelining are excluded from aliasing.
      * @return Optimizer output.
      */
-    RGCompilerResult<RGResOptOutput> optimizeResources(const std::vector<RGTask>& tasks) const noexcept
+    RGCompilerResult<RGResOptOutput> optimizeResources(const std::vector<RGTask>& tasks, const RGFramePipeline& framePipeline) const noexcept
     {
-        return RenderGraphResourceOptimizer(mRenderGraph, tasks).run();
+        const auto pinnedResources = framePipeline.duplicatedResources
+            | std::views::transform([](const RGDuplicatedResource& res){ return res.resourceId; })
+            | std::ranges::to<std::set<Id_t>>();
+
+        return RenderGraphResourceOptimizer(mRenderGraph, tasks, pinnedResources, mOptions.heapAliasing).run();
     }
 
     // =======================================
@@ -330,6 +606,19 @@ private:
         return templates;
     }
 
+    // =======================================
+    // Render Graph Compiler Phase : Lowering
+    // =======================================
+
+    /** Render Graph Compiler : Step 5
+     * Lower the compiler output into a flat execution plan for per-frame replay.
+     * @return Plan of the tasks, queue synchronization and transient allocations.
+     */
+    static RGExecutionPlan getExecutionPlan(const RGCompilerOutput& output)
+    {
+        return RGExecutionPlan::lower(output);
+    }
+
 private:
     template <class T>
     static RGCompilerOutput createErrorOutput(const RGCompilerResult<T>& result)
@@ -358,17 +647,20 @@ private:
         return static_cast<int32_t>(std::distance(std::begin(nodeIds), find));
     }
 
-    static RGCompilerResult<Pass*> getRootNode(RenderGraph& renderGraph)
+    static RGCompilerResult<Pass*> getRootNode(const RGPassTable& passTable)
     {
-        const auto beginPass = std::ranges::find_if(renderGraph.mVertices,[](const auto& pass) {
-            return pass->flags.sentinel && pass->name == rgRootPass;
-        });
-
-        if (beginPass == std::end(renderGraph.mVertices))
+        const auto rootSymbol = passTable.findSymbol(rgRootPass);
+        if (rootSymbol.has_value())
         {
-            return std::unexpected(RGCompilerError::NoRootNode);
+            for (const uint32_t slot : passTable.select(RGPassFlag_Sentinel))
+            {
+                if (passTable.nameSymbol(slot) == rootSymbol.value())
+                {
+                    return passTable.pass(slot);
+                }
+            }
         }
-        return beginPass->get();
+        return std::unexpected(RGCompilerError::NoRootNode);
     }
 
 private:
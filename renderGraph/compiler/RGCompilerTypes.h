@@ -1,8 +1,10 @@
 #pragma once
 
 #include <expected>
+#include <filesystem>
 #include <map>
 #include <optional>
+#include <string>
 #include <vector>
 
 // =======================================
@@ -24,6 +26,19 @@ enum class RGCompilerError
     NoNodeByGivenId,
 };
 
+constexpr std::string toString(const RGCompilerError error) noexcept
+{
+    using enum RGCompilerError;
+    switch (error)
+    {
+        case None             : return "none";
+        case NoRootNode       : return "no root node";
+        case CyclicDependency : return "cyclic dependency";
+        case NoNodeByGivenId  : return "no node by given id";
+    }
+    return std::string(rgUnknownEnumStr);
+}
+
 template <class T>
 using RGCompilerResult = std::expected<T, RGCompilerError>;
 
@@ -32,7 +47,20 @@ using RGCompilerResult = std::expected<T, RGCompilerError>;
 // =======================================
 struct RGCompilerOptions
 {
-    bool allowParallelization = false;
+    bool                  allowParallelization = false;
+    int32_t               framesInFlight       = 1;       // Frames allowed to overlap on the GPU, 1 disables cross-frame pipelining
+    bool                  memoryAwareOrdering  = false;   // Reorder passes to minimize the peak of simultaneously live resources
+    int32_t               orderingLookahead    = 2;       // Steps evaluated per candidate by the memory-aware ordering
+    int32_t               orderingCandidates   = 4;       // Ready passes explored per lookahead step by the memory-aware ordering
+    bool                  heapAliasing         = false;   // Share memory heaps between resources of one type in incompatible alias classes
+    std::filesystem::path planCacheDirectory   = {};      // Directory of the on-disk execution plan cache, empty disables it
+};
+
+/** Only filled in with <RGCompilerOptions::memoryAwareOrdering> enabled. */
+struct RGOrderingStats
+{
+    int32_t peakLiveBefore = 0;
+    int32_t peakLiveAfter  = 0;
 };
 
 struct RGResourceLink
@@ -59,16 +87,81 @@ static bool isUsedByTask(const RGResourceTemplate& resourceTemplate, const RGTas
     }) != std::end(resourceTemplate.links);
 }
 
+/**
+ * A task of the steady-state (modulo) schedule.
+ * Frame offsets are relative to the frame the schedule period belongs to,
+ * a pass with an offset of 1 is executed on behalf of the next frame.
+ */
+struct RGPipelinedTask
+{
+    RGTask  task;
+    int32_t passFrameOffset  = 0;
+    int32_t asyncFrameOffset = 0;
+};
+
+struct RGDuplicatedResource
+{
+    Id_t    resourceId = rgInvalidId;
+    Id_t    passId     = rgInvalidId;
+    int32_t copies     = 1;
+};
+
+/**
+ * Steady-state schedule for a backend overlapping frames in flight.
+ * Advisory, the queue sync plan and the execution plan describe the single frame task order.
+ */
+struct RGFramePipeline
+{
+    int32_t                             framesInFlight      = 1;
+    int32_t                             initiationInterval  = 0;    // Length of one steady-state period in tasks
+    std::vector<RGPipelinedTask>        steadyStateTasks;
+    std::vector<Id_t>                   hoistedPasses;              // Passes executed during the previous frame's tail
+    std::vector<RGDuplicatedResource>   duplicatedResources;        // Resources requiring a copy per overlapping frame
+};
+
+/**
+ * Topological levels of the remaining passes, all dependencies of a pass are in earlier levels.
+ * The passes of a level can be recorded concurrently, levels are submitted in order.
+ */
+struct RGWavefronts
+{
+    std::vector<std::vector<Id_t>> levels;      // Passes of each level in serial execution order
+    std::map<Id_t, int32_t>        levelOf;     // Pass ID -> Level index
+};
+
+/** Transitive reduction of the remaining passes, with the reachability computed alongside it. */
+struct RGTransitiveReduction
+{
+    std::vector<std::pair<Id_t, Id_t>> edges;           // (src, dst) Node ID pairs of the reduction
+    std::map<Id_t, uint32_t>           vertexOf;        // Node ID -> Vertex of <reachability>
+    Reachability                       reachability;
+
+    /** @return Whether a path leads from either pass to the other, both have to be remaining passes. */
+    bool isOrdered(const Id_t a, const Id_t b) const
+    {
+        const uint32_t va = vertexOf.at(a);
+        const uint32_t vb = vertexOf.at(b);
+        return reachability.reaches(va, vb) || reachability.reaches(vb, va);
+    }
+};
+
 // =======================================
+#include "RGQueueSync.h"
 #include "RGResourceOptTypes.h"
+#include "RGExecutionPlan.h"
 // =======================================
 
 struct RGCompilerPhaseOutputs
 {
     std::vector<Id_t>                   cullNodes;
     std::vector<Id_t>                   serialExecutionOrder;
+    RGOrderingStats                     orderingStats;
+    std::vector<std::pair<Id_t, Id_t>>  transitiveReduction;
     std::map<Id_t, std::vector<Id_t>>   parallelizableNodes;
     std::vector<RGTask>                 taskOrder;
+    RGFramePipeline                     framePipeline;
+    RGQueueSyncPlan                     queueSync;
+    RGWavefronts                        wavefronts;
     RGResOptOutput                      resourceOptimizer;
 };
 
@@ -79,4 +172,5 @@ struct RGCompilerOutput
     RGCompilerError                       failReason    = RGCompilerError::None;
     std::optional<RGCompilerPhaseOutputs> phaseOutputs  = std::nullopt;
     RGCompilerOptions                     options       = {};
+    RGExecutionPlan                       executionPlan;
 };
\ No newline at end of file
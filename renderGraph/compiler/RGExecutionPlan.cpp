@@ -0,0 +1,369 @@
+#include "RGExecutionPlan.h"
+
+#include <bit>
+#include <map>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "RGCompilerTypes.h"
+
+namespace
+{
+    constexpr size_t alignOffset(const size_t offset)
+    {
+        return (offset + rgPlanAlignment - 1) & ~(rgPlanAlignment - 1);
+    }
+
+    /** Append a record or section, padded to the plan alignment. */
+    template <class T>
+    size_t emit(std::vector<std::byte>& data, const T& value)
+    {
+        const size_t offset = data.size();
+        data.resize(alignOffset(offset + sizeof(T)));
+        std::memcpy(data.data() + offset, &value, sizeof(T));
+        return offset;
+    }
+
+    template <class T>
+    RGPlanRecord recordHeader(const RGPlanOp op)
+    {
+        return { .op = op, .size = static_cast<uint16_t>(alignOffset(sizeof(T))) };
+    }
+
+    /** @return Size of the record type of <op>, 0 if the op is unknown. */
+    constexpr size_t recordSize(const RGPlanOp op) noexcept
+    {
+        using enum RGPlanOp;
+        switch (op)
+        {
+            case BeginTask : return sizeof(RGPlanBeginTask);
+            case EndTask   : return sizeof(RGPlanEndTask);
+            case Alloc     : return sizeof(RGPlanAlloc);
+            case Free      : return sizeof(RGPlanFree);
+            case Wait      : return sizeof(RGPlanWait);
+            case Acquire   :
+            case Release   : return sizeof(RGPlanOwnershipTransfer);
+            case Submit    : return sizeof(RGPlanSubmit);
+        }
+        return 0;
+    }
+
+    template <class T> requires std::is_integral_v<T> || std::is_enum_v<T>
+    void swapBytes(T& value) noexcept
+    {
+        if constexpr (std::is_enum_v<T>)
+        {
+            value = static_cast<T>(std::byteswap(std::to_underlying(value)));
+        }
+        else
+        {
+            value = std::byteswap(value);
+        }
+    }
+
+    template <class... T>
+    void swapFields(T&... fields) noexcept
+    {
+        (swapBytes(fields), ...);
+    }
+
+    void swapBytes(RGPlanRecord& record) noexcept
+    {
+        swapFields(record.op, record.size);
+    }
+
+    /** Swap the header of a record, then the given fields of its record type. */
+    template <class T>
+    void swapRecord(T& record, auto&... fields) noexcept
+    {
+        swapBytes(record.header);
+        swapFields(fields...);
+    }
+
+    void swapBytes(RGPlanBeginTask& record) noexcept         { swapRecord(record, record.taskIdx); }
+    void swapBytes(RGPlanEndTask& record) noexcept           { swapRecord(record, record.taskIdx); }
+    void swapBytes(RGPlanAlloc& record) noexcept             { swapRecord(record, record.physId, record.dedicated, record.bytes, record.offset); }
+    void swapBytes(RGPlanFree& record) noexcept              { swapRecord(record, record.physId); }
+    void swapBytes(RGPlanWait& record) noexcept              { swapRecord(record, record.waitQueue, record.signalQueue, record.value); }
+    void swapBytes(RGPlanOwnershipTransfer& record) noexcept { swapRecord(record, record.resourceId, record.srcQueue, record.dstQueue); }
+    void swapBytes(RGPlanSubmit& record) noexcept            { swapRecord(record, record.passIdx, record.queue, record.signalValue); }
+
+    void swapBytes(RGExecutionPlanHeader& header) noexcept
+    {
+        swapFields(header.magic, header.version, header.passCount, header.passTableOffset, header.taskCount,
+            header.taskTableOffset, header.codeOffset, header.codeSize, header.transientArenaSize);
+    }
+
+    /** Swap the <T> at <offset> in place, the caller checks that it is inside the data. */
+    template <class T>
+    void swapAt(const std::span<std::byte> data, const size_t offset) noexcept
+    {
+        T value;
+        std::memcpy(&value, data.data() + offset, sizeof(T));
+        swapBytes(value);
+        std::memcpy(data.data() + offset, &value, sizeof(T));
+    }
+
+    /** Group elements by a key, so each group is looked up once instead of filtering the whole list. */
+    template <class T, class Key>
+    std::map<Key, std::vector<const T*>> groupBy(const std::vector<T>& elements, Key T::* key)
+    {
+        std::map<Key, std::vector<const T*>> groups;
+        for (const auto& element : elements)
+        {
+            groups[element.*key].push_back(&element);
+        }
+        return groups;
+    }
+
+    template <class T, class Key>
+    std::span<const T* const> groupOf(const std::map<Key, std::vector<const T*>>& groups, const Key key)
+    {
+        const auto it = groups.find(key);
+        return it == std::end(groups) ? std::span<const T* const> {} : std::span<const T* const>(it->second);
+    }
+}
+
+bool RGExecutionPlanView::isValid() const noexcept
+{
+    if (mData.size() < sizeof(RGExecutionPlanHeader))
+    {
+        return false;
+    }
+
+    const auto hdr = header();
+    const size_t codeEnd = static_cast<size_t>(hdr.codeOffset) + hdr.codeSize;
+    if (hdr.magic != rgPlanMagic
+        || hdr.version != rgPlanVersion
+        || static_cast<size_t>(hdr.passTableOffset) + hdr.passCount * sizeof(Id_t) > mData.size()
+        || static_cast<size_t>(hdr.taskTableOffset) + hdr.taskCount * sizeof(uint32_t) > mData.size()
+        || codeEnd > mData.size())
+    {
+        return false;
+    }
+
+    for (uint32_t taskIdx = 0; taskIdx < hdr.taskCount; taskIdx++)
+    {
+        const auto beginOffset = read<uint32_t>(hdr.taskTableOffset + taskIdx * sizeof(uint32_t));
+        if (beginOffset < hdr.codeOffset || beginOffset >= codeEnd)
+        {
+            return false;
+        }
+    }
+
+    // Every record has to be known, aligned and end inside the code, execute() relies on it.
+    for (size_t offset = hdr.codeOffset; offset < codeEnd;)
+    {
+        if (codeEnd - offset < sizeof(RGPlanRecord))
+        {
+            return false;
+        }
+
+        const auto record = read<RGPlanRecord>(offset);
+        const auto size   = recordSize(record.op);
+        if (size == 0 || record.size < size || record.size % rgPlanAlignment != 0 || record.size > codeEnd - offset)
+        {
+            return false;
+        }
+
+        if (record.op == RGPlanOp::Submit && read<RGPlanSubmit>(offset).passIdx >= hdr.passCount)
+        {
+            return false;
+        }
+        offset += record.size;
+    }
+    return true;
+}
+
+void RGExecutionPlan::byteswap(const std::span<std::byte> data, const bool fromNative) noexcept
+{
+    if (data.size() < sizeof(RGExecutionPlanHeader))
+    {
+        return;
+    }
+
+    const auto inside = [&data](const size_t offset, const size_t size) {
+        return offset <= data.size() && size <= data.size() - offset;
+    };
+
+    RGExecutionPlanHeader hdr;
+    std::memcpy(&hdr, data.data(), sizeof(hdr));
+    swapAt<RGExecutionPlanHeader>(data, 0);
+    if (!fromNative)
+    {
+        swapBytes(hdr);
+    }
+
+    for (size_t i = 0; i < hdr.passCount && inside(hdr.passTableOffset + i * sizeof(Id_t), sizeof(Id_t)); i++)
+    {
+        swapAt<Id_t>(data, hdr.passTableOffset + i * sizeof(Id_t));
+    }
+    for (size_t i = 0; i < hdr.taskCount && inside(hdr.taskTableOffset + i * sizeof(uint32_t), sizeof(uint32_t)); i++)
+    {
+        swapAt<uint32_t>(data, hdr.taskTableOffset + i * sizeof(uint32_t));
+    }
+
+    const size_t codeEnd = static_cast<size_t>(hdr.codeOffset) + hdr.codeSize;
+    for (size_t offset = hdr.codeOffset; offset < codeEnd && inside(offset, sizeof(RGPlanRecord));)
+    {
+        RGPlanRecord record;
+        std::memcpy(&record, data.data() + offset, sizeof(record));
+        if (!fromNative)
+        {
+            swapBytes(record);
+        }
+
+        const auto size = recordSize(record.op);
+        if (size == 0 || record.size < size || !inside(offset, record.size))
+        {
+            return;
+        }
+
+        switch (record.op)
+        {
+            using enum RGPlanOp;
+            case BeginTask : swapAt<RGPlanBeginTask>(data, offset);         break;
+            case EndTask   : swapAt<RGPlanEndTask>(data, offset);           break;
+            case Alloc     : swapAt<RGPlanAlloc>(data, offset);             break;
+            case Free      : swapAt<RGPlanFree>(data, offset);              break;
+            case Wait      : swapAt<RGPlanWait>(data, offset);              break;
+            case Acquire   :
+            case Release   : swapAt<RGPlanOwnershipTransfer>(data, offset); break;
+            case Submit    : swapAt<RGPlanSubmit>(data, offset);            break;
+        }
+        offset += record.size;
+    }
+}
+
+RGExecutionPlan RGExecutionPlan::lower(const RGCompilerOutput& output)
+{
+    RGExecutionPlan plan;
+    if (output.hasFailed || !output.phaseOutputs.has_value())
+    {
+        return plan;
+    }
+
+    const auto& tasks      = output.phaseOutputs->taskOrder;
+    const auto& queueSync  = output.phaseOutputs->queueSync;
+    const auto& memEvents  = output.phaseOutputs->resourceOptimizer.memoryEvents;
+
+    // Pass table in submission order.
+    std::map<Id_t, uint32_t> passIdxOf;
+    for (const auto& submission : queueSync.submissions)
+    {
+        passIdxOf.try_emplace(submission.passId, static_cast<uint32_t>(passIdxOf.size()));
+    }
+
+    auto& data = plan.mData;
+    RGExecutionPlanHeader header = {
+        .magic              = rgPlanMagic,
+        .version            = rgPlanVersion,
+        .passCount          = static_cast<uint32_t>(passIdxOf.size()),
+        .passTableOffset    = 0,
+        .taskCount          = static_cast<uint32_t>(tasks.size()),
+        .taskTableOffset    = 0,
+        .codeOffset         = 0,
+        .codeSize           = 0,
+        .transientArenaSize = output.phaseOutputs->resourceOptimizer.transientArenaSize,
+    };
+    emit(data, header);
+
+    header.passTableOffset = static_cast<uint32_t>(data.size());
+    std::vector<Id_t> passTable(passIdxOf.size());
+    for (const auto& [passId, passIdx] : passIdxOf)
+    {
+        passTable[passIdx] = passId;
+    }
+    data.resize(alignOffset(data.size() + passTable.size() * sizeof(Id_t)));
+    std::memcpy(data.data() + header.passTableOffset, passTable.data(), passTable.size() * sizeof(Id_t));
+
+    // Task table entries are patched once the records are emitted.
+    header.taskTableOffset = static_cast<uint32_t>(data.size());
+    data.resize(alignOffset(data.size() + tasks.size() * sizeof(uint32_t)));
+
+    // Synchronization grouped by task and pass.
+    const auto submissionsOfTask = groupBy(queueSync.submissions, &RGQueueSubmission::taskIdx);
+    const auto waitsOfPass       = groupBy(queueSync.waits, &RGSemaphoreWait::waitingPass);
+    const auto acquiresOfPass    = groupBy(queueSync.ownershipTransfers, &RGOwnershipTransfer::dstPass);
+    const auto releasesOfPass    = groupBy(queueSync.ownershipTransfers, &RGOwnershipTransfer::srcPass);
+
+    header.codeOffset = static_cast<uint32_t>(data.size());
+    auto memEvent = std::begin(memEvents);
+    for (int32_t taskIdx = 0; taskIdx < static_cast<int32_t>(tasks.size()); taskIdx++)
+    {
+        const auto beginOffset = static_cast<uint32_t>(emit(data, RGPlanBeginTask {
+            .header  = recordHeader<RGPlanBeginTask>(RGPlanOp::BeginTask),
+            .taskIdx = taskIdx,
+        }));
+        std::memcpy(data.data() + header.taskTableOffset + taskIdx * sizeof(uint32_t), &beginOffset, sizeof(uint32_t));
+
+        for (; memEvent != std::end(memEvents) && memEvent->taskIdx == taskIdx && memEvent->type == RGMemoryEventType::Alloc; ++memEvent)
+        {
+            emit(data, RGPlanAlloc {
+                .header    = recordHeader<RGPlanAlloc>(RGPlanOp::Alloc),
+                .physId    = memEvent->physId,
+                .dedicated = memEvent->dedicated,
+                .bytes     = memEvent->bytes,
+                .offset    = memEvent->offset,
+            });
+        }
+
+        for (const auto* submission : groupOf(submissionsOfTask, taskIdx))
+        {
+            for (const auto* wait : groupOf(waitsOfPass, submission->passId))
+            {
+                emit(data, RGPlanWait {
+                    .header      = recordHeader<RGPlanWait>(RGPlanOp::Wait),
+                    .waitQueue   = wait->waitQueue,
+                    .signalQueue = wait->signalQueue,
+                    .value       = wait->value,
+                });
+            }
+
+            for (const auto* transfer : groupOf(acquiresOfPass, submission->passId))
+            {
+                emit(data, RGPlanOwnershipTransfer {
+                    .header     = recordHeader<RGPlanOwnershipTransfer>(RGPlanOp::Acquire),
+                    .resourceId = transfer->resourceId,
+                    .srcQueue   = transfer->srcQueue,
+                    .dstQueue   = transfer->dstQueue,
+                });
+            }
+
+            emit(data, RGPlanSubmit {
+                .header      = recordHeader<RGPlanSubmit>(RGPlanOp::Submit),
+                .passIdx     = passIdxOf.at(submission->passId),
+                .queue       = submission->queue,
+                .signalValue = submission->signalValue,
+            });
+
+            for (const auto* transfer : groupOf(releasesOfPass, submission->passId))
+            {
+                emit(data, RGPlanOwnershipTransfer {
+                    .header     = recordHeader<RGPlanOwnershipTransfer>(RGPlanOp::Release),
+                    .resourceId = transfer->resourceId,
+                    .srcQueue   = transfer->srcQueue,
+                    .dstQueue   = transfer->dstQueue,
+                });
+            }
+        }
+
+        for (; memEvent != std::end(memEvents) && memEvent->taskIdx == taskIdx; ++memEvent)
+        {
+            emit(data, RGPlanFree {
+                .header = recordHeader<RGPlanFree>(RGPlanOp::Free),
+                .physId = memEvent->physId,
+            });
+        }
+
+        emit(data, RGPlanEndTask {
+            .header  = recordHeader<RGPlanEndTask>(RGPlanOp::EndTask),
+            .taskIdx = taskIdx,
+        });
+    }
+    header.codeSize = static_cast<uint32_t>(data.size() - header.codeOffset);
+
+    std::memcpy(data.data(), &header, sizeof(header));
+    return plan;
+}
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "RGQueueSync.h"
+
+struct RGCompilerOutput;
+
+// =======================================
+// Execution Plan : Records
+// =======================================
+enum class RGPlanOp : uint16_t
+{
+    BeginTask,
+    Alloc,
+    Wait,
+    Acquire,
+    Submit,
+    Release,
+    Free,
+    EndTask,
+};
+
+/** Common header of every record, the next record starts <size> bytes after this one. */
+struct RGPlanRecord
+{
+    RGPlanOp op;
+    uint16_t size;
+};
+
+struct RGPlanBeginTask
+{
+    RGPlanRecord header;
+    int32_t      taskIdx;
+};
+
+struct RGPlanEndTask
+{
+    RGPlanRecord header;
+    int32_t      taskIdx;
+};
+
+/** Allocation of a physical resource from the transient arena, <offset> is unused for dedicated allocations. */
+struct RGPlanAlloc
+{
+    RGPlanRecord header;
+    int32_t      physId;
+    uint32_t     dedicated;
+    uint64_t     bytes;
+    uint64_t     offset;
+};
+
+struct RGPlanFree
+{
+    RGPlanRecord header;
+    int32_t      physId;
+};
+
+/** Wait on the timeline semaphore of <signalQueue> before the next submission to <waitQueue>. */
+struct RGPlanWait
+{
+    RGPlanRecord header;
+    RGQueue      waitQueue;
+    RGQueue      signalQueue;
+    uint64_t     value;
+};
+
+/** Queue family ownership transfer, used by both Acquire and Release records. */
+struct RGPlanOwnershipTransfer
+{
+    RGPlanRecord header;
+    Id_t         resourceId;
+    RGQueue      srcQueue;
+    RGQueue      dstQueue;
+};
+
+/** Execute the pass at <passIdx> of the pass table, then signal the queue's timeline semaphore with <signalValue>. */
+struct RGPlanSubmit
+{
+    RGPlanRecord header;
+    uint32_t     passIdx;
+    RGQueue      queue;
+    uint64_t     signalValue;
+};
+
+// =======================================
+// Execution Plan
+// =======================================
+
+/**
+ * Layout : [Header][Pass table : Id_t x passCount][Task table : uint32_t x taskCount][Code : Records]
+ * Offsets are relative to the start of the plan, task table entries point at the BeginTask record of the task.
+ * All sections and records are aligned to <rgPlanAlignment>.
+ */
+struct RGExecutionPlanHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t passCount;
+    uint32_t passTableOffset;
+    uint32_t taskCount;
+    uint32_t taskTableOffset;
+    uint32_t codeOffset;
+    uint32_t codeSize;
+    uint64_t transientArenaSize;
+};
+
+constexpr uint32_t rgPlanMagic     = 0x4E4C5052;    // "RPLN"
+constexpr uint32_t rgPlanVersion   = 2;
+constexpr size_t   rgPlanAlignment = alignof(uint64_t);
+
+/**
+ * Non-owning view of a plan, usable on any suitably aligned copy of its bytes.
+ * Records are read by value, iterating the plan does not allocate.
+ */
+class RGExecutionPlanView
+{
+public:
+    RGExecutionPlanView() = default;
+
+    explicit RGExecutionPlanView(const std::span<const std::byte> data)
+    : mData(data)
+    {
+    }
+
+    /**
+     * @return Whether the bytes hold a plan of the current version with sections inside the data,
+     * and every record has a known op and a size covering its type inside the code section.
+     */
+    bool isValid() const noexcept;
+
+    RGExecutionPlanHeader header() const noexcept
+    {
+        return read<RGExecutionPlanHeader>(0);
+    }
+
+    Id_t passId(const uint32_t passIdx) const noexcept
+    {
+        return read<Id_t>(header().passTableOffset + passIdx * sizeof(Id_t));
+    }
+
+    /**
+     * Invoke <visitor> with every record in plan order, the plan has to be valid.
+     * The visitor has to accept each of the record types.
+     */
+    template <class Visitor>
+    void execute(Visitor&& visitor) const
+    {
+        const auto hdr = header();
+        size_t offset = hdr.codeOffset;
+        const size_t end = offset + hdr.codeSize;
+        while (offset < end)
+        {
+            const auto record = read<RGPlanRecord>(offset);
+            switch (record.op)
+            {
+                using enum RGPlanOp;
+                case BeginTask : visitor(read<RGPlanBeginTask>(offset));         break;
+                case EndTask   : visitor(read<RGPlanEndTask>(offset));           break;
+                case Alloc     : visitor(read<RGPlanAlloc>(offset));             break;
+                case Free      : visitor(read<RGPlanFree>(offset));              break;
+                case Wait      : visitor(read<RGPlanWait>(offset));              break;
+                case Acquire   :
+                case Release   : visitor(read<RGPlanOwnershipTransfer>(offset)); break;
+                case Submit    : visitor(read<RGPlanSubmit>(offset));            break;
+            }
+            offset += record.size;
+        }
+    }
+
+    std::span<const std::byte> data() const noexcept { return mData; }
+
+private:
+    template <class T>
+    T read(const size_t offset) const noexcept
+    {
+        T value;
+        std::memcpy(&value, mData.data() + offset, sizeof(T));
+        return value;
+    }
+
+    std::span<const std::byte> mData;
+};
+
+/**
+ * Self-contained, contiguous lowering of the compiler output for per-frame replay by RGPlanReplayer.
+ * Passes are referenced by their index in the pass table, the plan holds no pointers or strings.
+ */
+class RGExecutionPlan
+{
+public:
+    RGExecutionPlan() = default;
+
+    /**
+     * Lower the task order, queue synchronization and transient memory events of a compiler output.
+     * @return Empty plan if the compilation has failed.
+     */
+    static RGExecutionPlan lower(const RGCompilerOutput& output);
+
+    RGExecutionPlanView view() const noexcept { return RGExecutionPlanView(mData); }
+
+    /**
+     * Reverse the byte order of every field of the plan bytes in place, used to store plans little-endian.
+     * Offsets and record sizes are read from the native side, <fromNative> tells which side the bytes are on.
+     * The walk stops at the first record it can't size, validation of the swapped plan rejects it.
+     */
+    static void byteswap(std::span<std::byte> data, bool fromNative) noexcept;
+
+    bool empty() const noexcept { return mData.empty(); }
+
+private:
+    std::vector<std::byte> mData;
+};
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+// NEON is only used on AArch64, where it is always available and has across-vector reductions.
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #include <arm_neon.h>
+#endif
+
+/**
+ * Usage bounds of the physical resource timelines as separate start / end arrays,
+ * so an incoming interval can be tested against multiple timelines per instruction.
+ */
+struct RGTimelineBounds
+{
+    std::vector<int32_t> starts;
+    std::vector<int32_t> ends;
+
+    void push(const int32_t start, const int32_t end)
+    {
+        starts.push_back(start);
+        ends.push_back(end);
+    }
+
+    void update(const size_t idx, const int32_t start, const int32_t end)
+    {
+        starts[idx] = start;
+        ends[idx]   = end;
+    }
+
+    size_t size() const noexcept { return starts.size(); }
+
+    /** @return Index of the first timeline not overlapping [start, end], -1 if there is none. */
+    int32_t findFirstFree(const int32_t start, const int32_t end) const noexcept
+    {
+        const auto count = static_cast<int32_t>(starts.size());
+        const int32_t* pStarts = starts.data();
+        const int32_t* pEnds   = ends.data();
+
+        int32_t i = 0;
+#if defined(__AVX2__)
+        const __m256i vStart = _mm256_set1_epi32(start);
+        const __m256i vEnd   = _mm256_set1_epi32(end);
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256i s    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pStarts + i));
+            const __m256i e    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pEnds + i));
+            const __m256i free = _mm256_or_si256(_mm256_cmpgt_epi32(s, vEnd), _mm256_cmpgt_epi32(vStart, e));
+            if (const auto mask = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(free))))
+            {
+                return i + std::countr_zero(mask);
+            }
+        }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+        const int32x4_t vStart = vdupq_n_s32(start);
+        const int32x4_t vEnd   = vdupq_n_s32(end);
+        for (; i + 4 <= count; i += 4)
+        {
+            const uint32x4_t free = vorrq_u32(
+                vcgtq_s32(vld1q_s32(pStarts + i), vEnd),
+                vcgtq_s32(vStart, vld1q_s32(pEnds + i)));
+            if (vmaxvq_u32(free) != 0)
+            {
+                break;
+            }
+        }
+#endif
+        for (; i < count; i++)
+        {
+            if (pStarts[i] > end || start > pEnds[i])
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+};
+
+/**
+ * Disjoint lifetimes aliased into one physical resource, keyed by their start.
+ * A lifetime fits if it lies in any gap between the existing ones, which is answered in O(log n).
+ */
+class RGTimelineIntervals
+{
+public:
+    void insert(const int32_t start, const int32_t end)
+    {
+        mIntervals.emplace(start, end);
+    }
+
+    bool fits(const int32_t start, const int32_t end) const
+    {
+        const auto next = mIntervals.upper_bound(start);
+        if (next != std::end(mIntervals) && next->first <= end)
+        {
+            return false;
+        }
+        return next == std::begin(mIntervals) || std::prev(next)->second < start;
+    }
+
+    /** @return End of the last lifetime before <start> and start of the first one after it, numeric limits if there is none. */
+    std::pair<int32_t, int32_t> neighbors(const int32_t start) const
+    {
+        const auto next = mIntervals.upper_bound(start);
+        return {
+            next == std::begin(mIntervals) ? std::numeric_limits<int32_t>::min() : std::prev(next)->second,
+            next == std::end(mIntervals)   ? std::numeric_limits<int32_t>::max() : next->first,
+        };
+    }
+
+    /** @return Whether every lifetime of <other> fits. */
+    bool fits(const RGTimelineIntervals& other) const
+    {
+        return std::ranges::all_of(other.mIntervals, [this](const auto& interval){ return fits(interval.first, interval.second); });
+    }
+
+    void insert(const RGTimelineIntervals& other)
+    {
+        mIntervals.insert(std::begin(other.mIntervals), std::end(other.mIntervals));
+    }
+
+private:
+    std::map<int32_t, int32_t> mIntervals;
+};
+
+/**
+ * Gaps between the lifetimes of all physical resources of an alias class, so a lifetime fitting into a hole of any
+ * resource is found without testing each resource. A gap (lo, hi) holds the lifetimes [start, end] with lo < start and end < hi.
+ * Gaps are bucketed by lo, a max segment tree over the buckets holds their largest hi.
+ */
+class RGGapIndex
+{
+public:
+    struct Gap
+    {
+        int32_t lo       = 0;
+        int32_t hi       = 0;
+        int32_t resource = -1;  // Index of the physical resource the gap belongs to
+    };
+
+    /** @param timelineLength Upper bound of the gap starts. */
+    explicit RGGapIndex(const int32_t timelineLength)
+    : mLeafCount(std::bit_ceil(static_cast<uint32_t>(std::max(timelineLength, 1))))
+    , mMaxHi(2 * mLeafCount, std::numeric_limits<int32_t>::min())
+    , mBuckets(mLeafCount)
+    {
+    }
+
+    /** Gaps open to either side and gaps which can't hold a single point are ignored. */
+    void insert(const Gap& gap)
+    {
+        if (!isIndexed(gap))
+        {
+            return;
+        }
+
+        mBuckets[gap.lo].emplace(gap.hi, gap.resource);
+        update(gap.lo);
+    }
+
+    void erase(const Gap& gap)
+    {
+        if (!isIndexed(gap))
+        {
+            return;
+        }
+
+        if (mBuckets[gap.lo].erase({ gap.hi, gap.resource }) > 0)
+        {
+            update(gap.lo);
+        }
+    }
+
+    /**
+     * Find the gap [start, end] fits into which starts closest before <start>, among those the one ending first.
+     * @return std::nullopt if no gap fits. O(log T)
+     */
+    std::optional<Gap> find(const int32_t start, const int32_t end) const
+    {
+        const int32_t limit = std::min(start, static_cast<int32_t>(mLeafCount));
+        const int32_t lo    = findLastFitting(1, 0, static_cast<int32_t>(mLeafCount), limit, end);
+        if (lo == -1)
+        {
+            return std::nullopt;
+        }
+
+        const auto [hi, resource] = *mBuckets[lo].upper_bound({ end, std::numeric_limits<int32_t>::max() });
+        return Gap { .lo = lo, .hi = hi, .resource = resource };
+    }
+
+private:
+    static bool isIndexed(const Gap& gap) noexcept
+    {
+        return gap.lo != std::numeric_limits<int32_t>::min()
+            && gap.hi != std::numeric_limits<int32_t>::max()
+            && gap.hi - gap.lo >= 2;
+    }
+
+    void update(const int32_t lo)
+    {
+        uint32_t node = mLeafCount + static_cast<uint32_t>(lo);
+        mMaxHi[node] = mBuckets[lo].empty() ? std::numeric_limits<int32_t>::min() : std::rbegin(mBuckets[lo])->first;
+        for (node /= 2; node > 0; node /= 2)
+        {
+            mMaxHi[node] = std::max(mMaxHi[2 * node], mMaxHi[2 * node + 1]);
+        }
+    }
+
+    /** @return Largest bucket below <limit> in [nodeLo, nodeHi) holding a gap ending after <end>, -1 if there is none. */
+    int32_t findLastFitting(const uint32_t node, const int32_t nodeLo, const int32_t nodeHi, const int32_t limit, const int32_t end) const
+    {
+        if (nodeLo >= limit || mMaxHi[node] <= end)
+        {
+            return -1;
+        }
+        if (nodeHi - nodeLo == 1)
+        {
+            return nodeLo;
+        }
+
+        const int32_t mid   = (nodeLo + nodeHi) / 2;
+        const int32_t right = findLastFitting(2 * node + 1, mid, nodeHi, limit, end);
+        return right != -1 ? right : findLastFitting(2 * node, nodeLo, mid, limit, end);
+    }
+
+    uint32_t                                           mLeafCount;
+    std::vector<int32_t>                               mMaxHi;      // Segment tree, leaves start at mLeafCount
+    std::vector<std::set<std::pair<int32_t, int32_t>>> mBuckets;    // Gap start -> (Gap end, Resource index)
+};
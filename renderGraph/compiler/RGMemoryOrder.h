@@ -0,0 +1,289 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <ranges>
+#include <set>
+#include <vector>
+
+#include "RGResourceOptTypes.h"
+#include "../RenderGraph.h"
+
+struct RGMemoryOrdering
+{
+    std::vector<Id_t> order;
+    int32_t           peakLiveBefore = 0;   // Peak live resources of the input order
+    int32_t           peakLiveAfter  = 0;   // Peak live resources of <order>
+};
+
+/**
+ * Topological ordering which picks among ready passes to minimize the peak of simultaneously live resources.
+ * A resource is live from the step of the pass writing it until the step of its last consumer.
+ */
+class RGMemoryAwareOrder
+{
+public:
+    RGMemoryAwareOrder(const RenderGraph* renderGraph, const std::vector<Id_t>& nodeIds)
+    {
+        const auto n = static_cast<int32_t>(nodeIds.size());
+        for (int32_t i = 0; i < n; i++)
+        {
+            mIndexOf[nodeIds[i]] = i;
+        }
+
+        mNodeIds = nodeIds;
+        mSuccessors.resize(n);
+        mInDegrees.resize(n, 0);
+        mBirths.resize(n, 0);
+        mDeadWrites.resize(n, 0);
+        mConsumes.resize(n);
+
+        std::set<std::pair<int32_t, int32_t>> passEdges;
+        std::map<std::pair<int32_t, Id_t>, std::set<int32_t>> consumers;
+        for (const auto& edge : renderGraph->getEdges())
+        {
+            if (!mIndexOf.contains(edge.src->mId) || !mIndexOf.contains(edge.dst->mId))
+            {
+                continue;
+            }
+
+            const int32_t src = mIndexOf.at(edge.src->mId);
+            const int32_t dst = mIndexOf.at(edge.dst->mId);
+            if (passEdges.emplace(src, dst).second)
+            {
+                mSuccessors[src].push_back(dst);
+                mInDegrees[dst]++;
+            }
+            if (const auto* srcRes = edge.srcResource())
+            {
+                consumers[{ src, srcRes->id }].insert(dst);
+            }
+        }
+
+        // Tracked resources : Every written resource which would take part in resource optimization.
+        for (int32_t i = 0; i < n; i++)
+        {
+            for (const auto& resource : renderGraph->getPassById(nodeIds[i])->dependencies)
+            {
+                if (resource.access != AccessType::Write || !isOptimizableResource(resource.type))
+                {
+                    continue;
+                }
+
+                const auto resIdx = static_cast<int32_t>(mConsumerCounts.size());
+                const auto& resConsumers = consumers[{ i, resource.id }];
+                mConsumerCounts.push_back(static_cast<int32_t>(resConsumers.size()));
+                mBirths[i]++;
+                if (resConsumers.empty())
+                {
+                    mDeadWrites[i]++;
+                }
+                for (const auto consumer : resConsumers)
+                {
+                    mConsumes[consumer].push_back(resIdx);
+                }
+            }
+        }
+    }
+
+    /**
+     * @param lookahead Number of steps evaluated past each candidate before it is picked.
+     * @param candidateLimit Ready passes explored per lookahead step, the ones leaving the fewest live resources first.
+     * @return Ordering of the nodes with the peak live resource count before and after reordering,
+     * the input order if reordering doesn't lower the peak.
+     */
+    RGMemoryOrdering execute(const int32_t lookahead, const int32_t candidateLimit) const
+    {
+        State state = createState();
+
+        RGMemoryOrdering result;
+        int32_t peak = 0;
+        while (!state.ready.empty())
+        {
+            // Every ready pass is a candidate, only the lookahead below it is limited.
+            int32_t bestIdx   = 0;
+            int32_t bestScore = std::numeric_limits<int32_t>::max();
+            for (int32_t i = 0; i < static_cast<int32_t>(state.ready.size()); i++)
+            {
+                const Step candidate = step(state, i);
+                const auto score     = std::max(candidate.stepLive, explore(state, lookahead - 1, candidateLimit));
+                undo(state, candidate);
+
+                if (score < bestScore)
+                {
+                    bestScore = score;
+                    bestIdx   = i;
+                }
+            }
+
+            result.order.push_back(mNodeIds[state.ready[bestIdx]]);
+            peak = std::max(peak, step(state, bestIdx).stepLive);
+        }
+
+        // The lookahead is bounded and can end up above the input order, which is kept unless it is strictly improved.
+        result.peakLiveBefore = peakLiveResources(mNodeIds);
+        result.peakLiveAfter  = peak;
+        if (result.peakLiveAfter >= result.peakLiveBefore)
+        {
+            result.order         = mNodeIds;
+            result.peakLiveAfter = result.peakLiveBefore;
+        }
+        return result;
+    }
+
+    /** @return Peak number of simultaneously live resources when executing the nodes in the given order. */
+    int32_t peakLiveResources(const std::vector<Id_t>& order) const
+    {
+        State state = createState();
+
+        int32_t peak = 0;
+        for (const auto id : order)
+        {
+            state.ready.assign(1, mIndexOf.at(id));
+            peak = std::max(peak, step(state, 0).stepLive);
+        }
+        return peak;
+    }
+
+private:
+    struct State
+    {
+        std::vector<int32_t> inDegrees;
+        std::vector<int32_t> remaining;
+        std::vector<int32_t> ready;         // Input order is the tie-breaker for deterministic results
+        int32_t              live = 0;
+    };
+
+    /** Executed step, undoing it restores the state it was applied to. */
+    struct Step
+    {
+        int32_t node       = -1;
+        int32_t readyIdx   = -1;
+        int32_t liveBefore = 0;
+        int32_t readied    = 0;     // Successors appended to the ready list
+        int32_t stepLive   = 0;     // Live resource count during the step
+    };
+
+    State createState() const
+    {
+        State state = {
+            .inDegrees = mInDegrees,
+            .remaining = mConsumerCounts,
+            .ready     = {},
+            .live      = 0,
+        };
+
+        for (int32_t i = 0; i < static_cast<int32_t>(mNodeIds.size()); i++)
+        {
+            if (state.inDegrees[i] == 0)
+            {
+                state.ready.push_back(i);
+            }
+        }
+        return state;
+    }
+
+    /** Execute ready[readyIdx], resources are allocated before and released after the step. */
+    Step step(State& state, const int32_t readyIdx) const
+    {
+        Step result = {
+            .node       = state.ready[readyIdx],
+            .readyIdx   = readyIdx,
+            .liveBefore = state.live,
+        };
+        state.ready.erase(std::begin(state.ready) + readyIdx);
+
+        state.live += mBirths[result.node];
+        result.stepLive = state.live;
+
+        state.live -= mDeadWrites[result.node];
+        for (const auto resIdx : mConsumes[result.node])
+        {
+            if (--state.remaining[resIdx] == 0)
+            {
+                state.live--;
+            }
+        }
+
+        for (const auto successor : mSuccessors[result.node])
+        {
+            if (--state.inDegrees[successor] == 0)
+            {
+                state.ready.push_back(successor);
+                result.readied++;
+            }
+        }
+
+        return result;
+    }
+
+    void undo(State& state, const Step& applied) const
+    {
+        for (const auto successor : mSuccessors[applied.node])
+        {
+            state.inDegrees[successor]++;
+        }
+        for (const auto resIdx : mConsumes[applied.node])
+        {
+            state.remaining[resIdx]++;
+        }
+
+        state.ready.resize(state.ready.size() - applied.readied);
+        state.ready.insert(std::begin(state.ready) + applied.readyIdx, applied.node);
+        state.live = applied.liveBefore;
+    }
+
+    /** @return Live resource count after executing <node> in the given state, without executing it. */
+    int32_t liveAfter(const State& state, const int32_t node) const
+    {
+        int32_t live = state.live + mBirths[node] - mDeadWrites[node];
+        for (const auto resIdx : mConsumes[node])
+        {
+            if (state.remaining[resIdx] == 1)
+            {
+                live--;
+            }
+        }
+        return live;
+    }
+
+    /** @return Lowest peak reachable within the next <depth> steps, exploring at most <candidateLimit> ready passes per step. */
+    int32_t explore(State& state, const int32_t depth, const int32_t candidateLimit) const
+    {
+        if (depth <= 0 || state.ready.empty())
+        {
+            return 0;
+        }
+
+        // (Live count after the step, ready index) of the candidates
+        std::vector<std::pair<int32_t, int32_t>> candidates;
+        candidates.reserve(state.ready.size());
+        for (int32_t i = 0; i < static_cast<int32_t>(state.ready.size()); i++)
+        {
+            candidates.emplace_back(liveAfter(state, state.ready[i]), i);
+        }
+        const auto limit = std::min(static_cast<size_t>(std::max(candidateLimit, 1)), candidates.size());
+        std::ranges::partial_sort(candidates, std::begin(candidates) + limit);
+        candidates.resize(limit);
+
+        int32_t best = std::numeric_limits<int32_t>::max();
+        for (const auto readyIdx : candidates | std::views::values)
+        {
+            const Step candidate = step(state, readyIdx);
+            best = std::min(best, std::max(candidate.stepLive, explore(state, depth - 1, candidateLimit)));
+            undo(state, candidate);
+        }
+        return best;
+    }
+
+    std::vector<Id_t>                 mNodeIds;
+    std::map<Id_t, int32_t>           mIndexOf;
+    std::vector<std::vector<int32_t>> mSuccessors;
+    std::vector<int32_t>              mInDegrees;
+    std::vector<int32_t>              mBirths;
+    std::vector<int32_t>              mDeadWrites;
+    std::vector<std::vector<int32_t>> mConsumes;
+    std::vector<int32_t>              mConsumerCounts;
+};
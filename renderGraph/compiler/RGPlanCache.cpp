@@ -0,0 +1,222 @@
+#include "RGPlanCache.h"
+
+#include <bit>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "RGCompilerTypes.h"
+#include "../RenderGraph.h"
+
+namespace
+{
+    constexpr bool isBigEndian = std::endian::native == std::endian::big;
+
+    /** 64-bit FNV-1a, stable across platforms and runs. */
+    struct FNV1a
+    {
+        uint64_t value = 0xCBF29CE484222325;
+
+        void add(const std::span<const std::byte> bytes) noexcept
+        {
+            for (const auto byte : bytes)
+            {
+                value = (value ^ static_cast<uint64_t>(byte)) * 0x100000001B3;
+            }
+        }
+
+        template <class T> requires std::is_integral_v<T>
+        void add(T value) noexcept
+        {
+            if constexpr (isBigEndian && sizeof(T) > 1)
+            {
+                value = std::byteswap(value);
+            }
+            add(std::as_bytes(std::span(&value, 1)));
+        }
+
+        template <class T> requires std::is_enum_v<T>
+        void add(const T value) noexcept
+        {
+            add(std::to_underlying(value));
+        }
+
+        void add(const std::string_view str) noexcept
+        {
+            add(str.size());
+            add(std::as_bytes(std::span(str)));
+        }
+    };
+
+    /** Convert the header between native and file byte order, the conversion is its own inverse. */
+    RGPlanCacheHeader toFileOrder(RGPlanCacheHeader header) noexcept
+    {
+        if constexpr (isBigEndian)
+        {
+            header.magic       = std::byteswap(header.magic);
+            header.version     = std::byteswap(header.version);
+            header.planVersion = std::byteswap(header.planVersion);
+            header.key         = std::byteswap(header.key);
+            header.planSize    = std::byteswap(header.planSize);
+            header.checksum    = std::byteswap(header.checksum);
+        }
+        return header;
+    }
+}
+
+uint64_t RGPlanCache::structuralHash(const RenderGraph& renderGraph, const RGCompilerOptions& options)
+{
+    FNV1a hash;
+    hash.add(rgPlanVersion);
+
+    hash.add(options.allowParallelization);
+    hash.add(options.framesInFlight);
+    hash.add(options.memoryAwareOrdering);
+    hash.add(options.orderingLookahead);
+    hash.add(options.orderingCandidates);
+    hash.add(options.heapAliasing);
+
+    for (const auto& pass : renderGraph.getVertices())
+    {
+        hash.add(pass->mId);
+        hash.add(std::string_view(pass->name));
+        for (const bool flag : { pass->flags.raster, pass->flags.compute, pass->flags.async, pass->flags.neverCull, pass->flags.sentinel })
+        {
+            hash.add(flag);
+        }
+
+        hash.add(pass->dependencies.size());
+        for (const auto& resource : pass->dependencies)
+        {
+            hash.add(resource.id);
+            hash.add(std::string_view(resource.name));
+            hash.add(resource.type);
+            hash.add(resource.access);
+            hash.add(resource.flags.dontOptimize);
+            hash.add(resource.desc.size);
+            hash.add(resource.desc.compatibility.format);
+            hash.add(resource.desc.compatibility.usage);
+            hash.add(resource.desc.compatibility.samples);
+        }
+    }
+
+    // Resources are resolved through the checked lookup, a stale handle hashes as an invalid ID.
+    for (const auto& edge : renderGraph.getEdges())
+    {
+        const auto* srcRes = renderGraph.getResource(edge.srcRes);
+        const auto* dstRes = renderGraph.getResource(edge.dstRes);
+        hash.add(edge.src->mId);
+        hash.add(edge.dst->mId);
+        hash.add(srcRes ? srcRes->id : rgInvalidId);
+        hash.add(dstRes ? dstRes->id : rgInvalidId);
+    }
+
+    return hash.value;
+}
+
+std::optional<RGCachedPlan> RGPlanCache::load(const RenderGraph& renderGraph, const RGCompilerOptions& options) const
+{
+    const auto key = structuralHash(renderGraph, options);
+    auto file = MappedFile::open(pathOf(key));
+    if (!file.has_value() || file->data().size() < sizeof(RGPlanCacheHeader))
+    {
+        return std::nullopt;
+    }
+
+    RGPlanCacheHeader header;
+    std::memcpy(&header, file->data().data(), sizeof(header));
+    header = toFileOrder(header);
+    if (header.magic != rgPlanCacheMagic
+        || header.version != rgPlanCacheVersion
+        || header.planVersion != rgPlanVersion
+        || header.key != key
+        || header.planSize != file->data().size() - sizeof(RGPlanCacheHeader))
+    {
+        return std::nullopt;
+    }
+
+    const auto planData = file->data().subspan(sizeof(RGPlanCacheHeader));
+    FNV1a checksum;
+    checksum.add(planData);
+    if (checksum.value != header.checksum)
+    {
+        return std::nullopt;
+    }
+
+    RGCachedPlan cached = {
+        .file       = std::move(file.value()),
+        .nativeData = {},
+        .plan       = RGExecutionPlanView(planData),
+    };
+    if constexpr (isBigEndian)
+    {
+        cached.nativeData.assign(std::begin(planData), std::end(planData));
+        RGExecutionPlan::byteswap(cached.nativeData, false);
+        cached.plan = RGExecutionPlanView(cached.nativeData);
+    }
+
+    if (!cached.plan.isValid())
+    {
+        return std::nullopt;
+    }
+    return cached;
+}
+
+bool RGPlanCache::store(const RenderGraph& renderGraph, const RGCompilerOptions& options, const RGExecutionPlan& plan) const
+{
+    if (plan.empty())
+    {
+        return false;
+    }
+
+    auto planData = plan.view().data();
+    std::vector<std::byte> swappedData;
+    if constexpr (isBigEndian)
+    {
+        swappedData.assign(std::begin(planData), std::end(planData));
+        RGExecutionPlan::byteswap(swappedData, true);
+        planData = swappedData;
+    }
+
+    FNV1a checksum;
+    checksum.add(planData);
+
+    const RGPlanCacheHeader header = {
+        .magic       = rgPlanCacheMagic,
+        .version     = rgPlanCacheVersion,
+        .planVersion = rgPlanVersion,
+        .reserved    = 0,
+        .key         = structuralHash(renderGraph, options),
+        .planSize    = planData.size(),
+        .checksum    = checksum.value,
+    };
+
+    std::error_code ec;
+    std::filesystem::create_directories(mDirectory, ec);
+
+    const auto fileHeader = toFileOrder(header);
+    const auto path       = pathOf(header.key);
+    auto       tmpPath    = path;
+    tmpPath += ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+        out.write(reinterpret_cast<const char*>(planData.data()), static_cast<std::streamsize>(planData.size()));
+        if (!out)
+        {
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tmpPath, path, ec);
+    return !ec;
+}
+
+std::filesystem::path RGPlanCache::pathOf(const uint64_t key) const
+{
+    return mDirectory / std::format("{:016x}.rgplan", key);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+#include "RGExecutionPlan.h"
+#include "../../platform/MappedFile.h"
+
+class RenderGraph;
+struct RGCompilerOptions;
+
+/**
+ * Layout : [Header][Execution plan : planSize bytes]
+ * Every field of the header and the plan is stored little-endian, big-endian machines byte swap on store and load.
+ */
+struct RGPlanCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t planVersion;
+    uint32_t reserved;      // Zero, keeps the 64-bit fields aligned
+    uint64_t key;           // Structural hash of the graph and compiler options
+    uint64_t planSize;
+    uint64_t checksum;      // FNV-1a of the plan bytes
+};
+
+constexpr uint32_t rgPlanCacheMagic   = 0x43504752;    // "RGPC"
+constexpr uint32_t rgPlanCacheVersion = 2;
+
+/** Execution plan loaded from the cache, the plan points into the mapped file or, on big-endian machines, its native copy. */
+struct RGCachedPlan
+{
+    MappedFile             file;
+    std::vector<std::byte> nativeData;  // Plan in native byte order, only used on big-endian machines
+    RGExecutionPlanView    plan;
+};
+
+/**
+ * On-disk cache of compiled execution plans, one file per graph and option set.
+ * Changing the graph or the options changes the key, stale files are simply never looked up again.
+ */
+class RGPlanCache
+{
+public:
+    explicit RGPlanCache(std::filesystem::path directory)
+    : mDirectory(std::move(directory))
+    {
+    }
+
+    /**
+     * Hash of everything the compiled plan depends on : passes, resources, edges and compiler options.
+     * Pass and resource IDs are included, as the plan references passes by ID. Values are hashed little-endian.
+     */
+    static uint64_t structuralHash(const RenderGraph& renderGraph, const RGCompilerOptions& options);
+
+    /** @return Mapped plan for the graph, std::nullopt if there is none or it fails validation. */
+    std::optional<RGCachedPlan> load(const RenderGraph& renderGraph, const RGCompilerOptions& options) const;
+
+    /** Write the plan for the graph, replacing any previous file atomically. */
+    bool store(const RenderGraph& renderGraph, const RGCompilerOptions& options, const RGExecutionPlan& plan) const;
+
+private:
+    std::filesystem::path pathOf(uint64_t key) const;
+
+    std::filesystem::path mDirectory;
+};
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <ranges>
+#include <set>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "../RenderGraphCore.h"
+
+enum class RGQueue
+{
+    Graphics,
+    Compute,
+};
+constexpr std::string toString(const RGQueue queue) noexcept
+{
+    using enum RGQueue;
+    switch (queue)
+    {
+        case Graphics : return "graphics";
+        case Compute  : return "compute";
+    }
+    return std::string(rgUnknownEnumStr);
+}
+
+constexpr int32_t rgQueueCount = 2;
+
+using RGQueueClock = std::array<uint64_t, rgQueueCount>;
+
+/**
+ * A single pass submitted to a queue.
+ * Each queue owns a timeline semaphore, which is signaled with <signalValue> once the pass completes.
+ */
+struct RGQueueSubmission
+{
+    Id_t     passId      = rgInvalidId;
+    int32_t  taskIdx     = -1;
+    RGQueue  queue       = RGQueue::Graphics;
+    uint64_t signalValue = 0;
+};
+
+/** Wait on the timeline semaphore of <signalQueue> before <waitingPass> is executed on <waitQueue>. */
+struct RGSemaphoreWait
+{
+    int32_t  taskIdx       = -1;
+    Id_t     waitingPass   = rgInvalidId;
+    RGQueue  waitQueue     = RGQueue::Graphics;
+    Id_t     signalingPass = rgInvalidId;
+    RGQueue  signalQueue   = RGQueue::Graphics;
+    uint64_t value         = 0;
+};
+
+/**
+ * Queue family ownership transfer of a resource shared across queues.
+ * The release barrier is recorded after <srcPass>, the acquire barrier before <dstPass>.
+ */
+struct RGOwnershipTransfer
+{
+    Id_t    resourceId     = rgInvalidId;
+    Id_t    srcPass        = rgInvalidId;
+    Id_t    dstPass        = rgInvalidId;
+    int32_t releaseTaskIdx = -1;
+    int32_t acquireTaskIdx = -1;
+    RGQueue srcQueue       = RGQueue::Graphics;
+    RGQueue dstQueue       = RGQueue::Compute;
+};
+
+struct RGQueueSyncPlan
+{
+    std::vector<RGQueueSubmission>   submissions;
+    std::vector<RGSemaphoreWait>     waits;
+    std::vector<RGOwnershipTransfer> ownershipTransfers;
+    int32_t                          redundantWaits = 0;    // Cross-queue dependencies already covered by other waits
+};
+
+struct RGQueueSync
+{
+    /**
+     * Plan cross-queue synchronization for the given task order.
+     * Main passes of tasks are submitted to the graphics queue, async passes to the compute queue.
+     * Only edges of the transitive reduction are considered as dependencies, the remaining ones are implied.
+     * Every submission carries a vector clock of the semaphore values it transitively waited for,
+     * a cross-queue dependency is only turned into a wait if the clock does not already cover it.
+     */
+    static RGQueueSyncPlan generate(
+        const std::vector<RGTask>&                  tasks,
+        const std::vector<Edge>&                    edges,
+        const std::vector<std::pair<Id_t, Id_t>>&   transitiveReduction)
+    {
+        RGQueueSyncPlan plan;
+
+        // Passes in submission order, graphics before compute within a task.
+        std::map<Id_t, int32_t> submissionOfPass;
+        RGQueueClock            queueValues = {};
+        for (const auto& [i, task] : std::views::enumerate(tasks))
+        {
+            for (const auto& [pass, queue] : { std::pair { task.pass, RGQueue::Graphics }, std::pair { task.asyncPass, RGQueue::Compute } })
+            {
+                if (!pass)
+                {
+                    continue;
+                }
+
+                const auto q = static_cast<int32_t>(queue);
+                submissionOfPass[pass->mId] = static_cast<int32_t>(plan.submissions.size());
+                plan.submissions.push_back({
+                    .passId      = pass->mId,
+                    .taskIdx     = static_cast<int32_t>(i),
+                    .queue       = queue,
+                    .signalValue = ++queueValues[q],
+                });
+            }
+        }
+
+        // Cross-queue dependencies per consumer submission, and ownership transfers per shared resource.
+        std::map<int32_t, std::set<int32_t>>  dependencies;
+        std::set<std::tuple<Id_t, Id_t, Id_t>> transfers;
+        const std::set<std::pair<Id_t, Id_t>>  reducedEdges(std::begin(transitiveReduction), std::end(transitiveReduction));
+        for (const auto& edge : edges)
+        {
+            if (!submissionOfPass.contains(edge.src->mId) || !submissionOfPass.contains(edge.dst->mId))
+            {
+                continue;
+            }
+
+            const auto  srcIdx = submissionOfPass.at(edge.src->mId);
+            const auto  dstIdx = submissionOfPass.at(edge.dst->mId);
+            const auto& src    = plan.submissions[srcIdx];
+            const auto& dst    = plan.submissions[dstIdx];
+            if (src.queue == dst.queue)
+            {
+                continue;
+            }
+
+            if (reducedEdges.contains({ src.passId, dst.passId }))
+            {
+                dependencies[dstIdx].insert(srcIdx);
+            }
+
+            const auto* srcRes = edge.srcResource();
+            if (srcRes && srcRes->type != ResourceType::External
+                && transfers.emplace(srcRes->id, src.passId, dst.passId).second)
+            {
+                plan.ownershipTransfers.push_back({
+                    .resourceId     = srcRes->id,
+                    .srcPass        = src.passId,
+                    .dstPass        = dst.passId,
+                    .releaseTaskIdx = src.taskIdx,
+                    .acquireTaskIdx = dst.taskIdx,
+                    .srcQueue       = src.queue,
+                    .dstQueue       = dst.queue,
+                });
+            }
+        }
+
+        // Drop waits which are implied by earlier waits on the same queue.
+        std::vector<RGQueueClock> clocks(plan.submissions.size());
+        std::array<RGQueueClock, rgQueueCount> known = {};
+        for (const auto& [i, submission] : std::views::enumerate(plan.submissions))
+        {
+            const auto q = static_cast<int32_t>(submission.queue);
+
+            // Latest required submission per signaling queue.
+            std::array<int32_t, rgQueueCount> required;
+            required.fill(-1);
+            for (const auto srcIdx : dependencies[static_cast<int32_t>(i)])
+            {
+                const auto& src = plan.submissions[srcIdx];
+                const auto  p   = static_cast<int32_t>(src.queue);
+                if (known[q][p] >= src.signalValue)
+                {
+                    plan.redundantWaits++;
+                    continue;
+                }
+                if (required[p] != -1)
+                {
+                    plan.redundantWaits++;
+                }
+                if (required[p] == -1 || plan.submissions[required[p]].signalValue < src.signalValue)
+                {
+                    required[p] = srcIdx;
+                }
+            }
+
+            for (const auto srcIdx : required)
+            {
+                if (srcIdx == -1)
+                {
+                    continue;
+                }
+
+                const auto& src = plan.submissions[srcIdx];
+                plan.waits.push_back({
+                    .taskIdx       = submission.taskIdx,
+                    .waitingPass   = submission.passId,
+                    .waitQueue     = submission.queue,
+                    .signalingPass = src.passId,
+                    .signalQueue   = src.queue,
+                    .value         = src.signalValue,
+                });
+
+                for (int32_t r = 0; r < rgQueueCount; r++)
+                {
+                    known[q][r] = std::max(known[q][r], clocks[srcIdx][r]);
+                }
+            }
+
+            known[q][q] = submission.signalValue;
+            clocks[i]   = known[q];
+        }
+
+        return plan;
+    }
+};
@@ -1,6 +1,14 @@
 #pragma once
 
+#include <atomic>
+#include <map>
+#include <set>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+
 #include "RGCompilerTypes.h"
+#include "RGIntervalScan.h"
 #include "RGResourceOptTypes.h"
 #include "../RenderGraph.h"
 
@@ -10,65 +18,84 @@
 class RenderGraphResourceOptimizer
 {
 public:
-    explicit RenderGraphResourceOptimizer(const RenderGraph* renderGraph, const std::vector<RGTask>& tasks)
+    explicit RenderGraphResourceOptimizer(
+        const RenderGraph*         renderGraph,
+        const std::vector<RGTask>& tasks,
+        const std::set<Id_t>&      pinnedResources = {},
+        const bool                 heapAliasing    = false)
     : mRenderGraph(renderGraph)
     , mTasks(tasks)
+    , mPinnedResources(pinnedResources)
+    , mHeapAliasing(heapAliasing)
     {
     }
 
     RGCompilerResult<RGResOptOutput> run() const
     {
         const auto R = evaluateRequiredResources();
-        std::vector<RGOptResource> generatedResources;
+        std::vector<Lifetime> lifetimes;
+        lifetimes.reserve(R.size());
+        std::map<RGAliasClass, std::vector<int32_t>> buckets;
 
+        // IDs are assigned up front, IdSequence may not be used by the bucket workers.
         int32_t nonOptmizeableCount = 0;
         for (const auto& res : R)
         {
-            RGOptResource resource = {
-                .id               = IdSequence::next(),
-                .usagePoints      = {},
-                .originalResource = *res.originResource,
-                .originalNode     = res.originNode->mId,
-                .type             = res.type
+            Lifetime lifetime = {
+                .resource = {
+                    .id               = IdSequence::next(),
+                    .usagePoints      = getUsagePointsForResourceInfo(res),
+                    .originalResource = *res.originResource,
+                    .originalNode     = res.originNode->mId,
+                    .type             = res.type,
+                    .size             = res.originResource->desc.size,
+                    .aliasClass       = RGAliasClass::of(*res.originResource),
+                },
             };
+            lifetime.range = Range(lifetime.resource.usagePoints);
 
-            auto& usagePoints = resource.usagePoints;
-            usagePoints = getUsagePointsForResourceInfo(res);
-
-            Range incomingRange(usagePoints);
-            if (!res.optimizable || res.originResource->flags.dontOptimize) {
-                generatedResources.push_back(resource);
+            if (!res.optimizable
+                || res.originResource->flags.dontOptimize
+                || !RGAliasClass::isAliasable(*res.originResource)
+                || mPinnedResources.contains(res.originResourceId))
+            {
+                lifetime.resource.aliasable = false;
                 nonOptmizeableCount++;
-                continue;
             }
-
-            // Case: No generated resources yet
-            if (generatedResources.empty()) {
-                generatedResources.push_back(resource);
-                continue;
+            else
+            {
+                buckets[lifetime.resource.aliasClass].push_back(static_cast<int32_t>(lifetimes.size()));
             }
+            lifetimes.push_back(std::move(lifetime));
+        }
 
-            // Case: There are generated resources, try inserting into an existing one
-            bool wasInserted = false;
-            for (auto& timeline : generatedResources) {
-                if (const Range currentRange = timeline.getUsageRange();
-                    !currentRange.overlaps(incomingRange))
-                {
-                    wasInserted = timeline.insertUsagePoints(usagePoints);
-                    if (wasInserted) {
-                        break;
-                    }
-                }
-            }
+        auto bucketResources = allocateBuckets(lifetimes, buckets);
 
-            // Case: Failed to Insert
-            if (!wasInserted) {
-                generatedResources.push_back(resource);
+        // Generated resources are ordered by their first lifetime, as if allocated sequentially.
+        for (const auto& [i, lifetime] : std::views::enumerate(lifetimes))
+        {
+            if (!lifetime.resource.aliasable)
+            {
+                bucketResources.push_back({ .first = static_cast<int32_t>(i), .resource = lifetime.resource });
             }
         }
+        std::ranges::sort(bucketResources, {}, &BucketResource::first);
+
+        std::vector<RGOptResource> generatedResources;
+        generatedResources.reserve(bucketResources.size());
+        for (const auto& bucketResource : bucketResources)
+        {
+            generatedResources.push_back(bucketResource.resource);
+        }
+
+        auto heaps = mHeapAliasing ? mergeHeaps(generatedResources, bucketResources) : std::vector<RGMemoryHeap> {};
+
+        const auto timelineLength = static_cast<int32_t>(mRenderGraph->mVertices.size());
 
         RGResOptOutput output = {
             .generatedResources = generatedResources,
+            .heaps              = std::move(heaps),
+            .names              = getNames(R),
             .originalResources  = R
                 | std::views::transform([](const auto& resInfo){ return *resInfo.originResource; })
                 | std::ranges::to<std::vector<Resource>>(),
@@ -76,76 +103,412 @@ public:
             .reduction          = static_cast<int32_t>(R.size() - generatedResources.size()),
             .preCount           = static_cast<int32_t>(R.size()),
             .postCount          = static_cast<int32_t>(generatedResources.size()),
-            .timelineRange      = { 0, static_cast<int32_t>(mRenderGraph->mVertices.size()) },
+            .timelineRange      = { 0, timelineLength },
         };
 
+        evaluateLowerBound(output, lifetimes, buckets, timelineLength);
+        evaluateMemoryEvents(output);
+
         return output;
     }
 
 private:
+    /** Required resource with its usage range on the resource timeline. */
+    struct Lifetime
+    {
+        RGOptResource resource;
+        Range         range;
+    };
+
+    /** Generated resource of an alias class, with the lifetimes aliased into it. */
+    struct BucketResource
+    {
+        int32_t             first = -1;     // Index of the first lifetime
+        RGOptResource       resource;
+        RGTimelineIntervals intervals;
+    };
+
+    /** Buckets with fewer lifetimes are allocated on the calling thread, thread startup would outweigh them. */
+    static constexpr size_t ParallelBucketSize = 256;
+
+    /**
+     * Allocate each bucket independently, buckets share no state.
+     * Large buckets are distributed over at most one worker per hardware thread, small ones run inline.
+     */
+    static std::vector<BucketResource> allocateBuckets(const std::vector<Lifetime>& lifetimes, const std::map<RGAliasClass, std::vector<int32_t>>& buckets)
+    {
+        const auto bucketList = buckets
+            | std::views::values
+            | std::views::transform([](const std::vector<int32_t>& bucket){ return &bucket; })
+            | std::ranges::to<std::vector<const std::vector<int32_t>*>>();
+
+        std::vector<std::vector<BucketResource>> results(bucketList.size());
+        std::vector<size_t> largeBuckets;
+        for (size_t i = 0; i < bucketList.size(); i++)
+        {
+            if (bucketList[i]->size() < ParallelBucketSize)
+            {
+                results[i] = allocateBucket(lifetimes, *bucketList[i]);
+            }
+            else
+            {
+                largeBuckets.push_back(i);
+            }
+        }
+
+        const auto workerCount = std::min<size_t>(largeBuckets.size(), std::max(std::thread::hardware_concurrency(), 1u));
+        std::atomic<size_t> nextBucket = 0;
+        const auto allocateLargeBuckets = [&]{
+            for (size_t i = nextBucket++; i < largeBuckets.size(); i = nextBucket++)
+            {
+                results[largeBuckets[i]] = allocateBucket(lifetimes, *bucketList[largeBuckets[i]]);
+            }
+        };
+
+        {
+            // The calling thread is one of the workers, the others are joined at the end of the scope.
+            std::vector<std::jthread> workers;
+            for (size_t i = 1; i < workerCount; i++)
+            {
+                workers.emplace_back(allocateLargeBuckets);
+            }
+            allocateLargeBuckets();
+        }
+
+        std::vector<BucketResource> bucketResources;
+        for (auto& result : results)
+        {
+            bucketResources.append_range(std::move(result));
+        }
+        return bucketResources;
+    }
+
+    /**
+     * Allocation of the lifetimes of one alias class.
+     * A lifetime is nested into a gap between the lifetimes of an existing resource if there is one, that leaves the
+     * resource bounds unchanged. Otherwise it is placed first-fit into the first resource with non-overlapping bounds.
+     */
+    static std::vector<BucketResource> allocateBucket(const std::vector<Lifetime>& lifetimes, const std::vector<int32_t>& bucket)
+    {
+        std::vector<BucketResource> result;
+        RGTimelineBounds bounds;
+
+        int32_t timelineLength = 0;
+        for (const auto lifetimeIdx : bucket)
+        {
+            timelineLength = std::max(timelineLength, lifetimes[lifetimeIdx].range.end + 1);
+        }
+        RGGapIndex gaps(timelineLength);
+
+        for (const auto lifetimeIdx : bucket)
+        {
+            const auto& [resource, range] = lifetimes[lifetimeIdx];
+
+            const auto gap = gaps.find(range.start, range.end);
+            const int32_t idx = gap.has_value() ? gap->resource : bounds.findFirstFree(range.start, range.end);
+
+            // Case: Insert into the existing resource the lifetime fits into
+            if (idx != -1)
+            {
+                auto& [first, timeline, intervals] = result[idx];
+                if (timeline.insertUsagePoints(resource.usagePoints))
+                {
+                    const Range newRange = timeline.getUsageRange();
+                    bounds.update(idx, newRange.start, newRange.end);
+
+                    // The lifetime splits the gap between its neighbors.
+                    const auto [prevEnd, nextStart] = intervals.neighbors(range.start);
+                    gaps.erase({ .lo = prevEnd, .hi = nextStart, .resource = idx });
+                    gaps.insert({ .lo = prevEnd, .hi = range.start, .resource = idx });
+                    gaps.insert({ .lo = range.end, .hi = nextStart, .resource = idx });
+
+                    intervals.insert(range.start, range.end);
+                    timeline.size = std::max(timeline.size, resource.size);
+                    continue;
+                }
+            }
+
+            // Case: No generated resources yet, or failed to insert
+            bounds.push(range.start, range.end);
+            result.push_back({ .first = lifetimeIdx, .resource = resource });
+            result.back().intervals.insert(range.start, range.end);
+        }
+
+        return result;
+    }
+
+    /**
+     * First-fit placement of the aliasable generated resources into memory heaps of their resource type.
+     * Resources of one alias class always overlap, so heaps are only shared across classes.
+     * Heap IDs are assigned here, after the bucket workers finished.
+     */
+    static std::vector<RGMemoryHeap> mergeHeaps(std::vector<RGOptResource>& generatedResources, const std::vector<BucketResource>& bucketResources)
+    {
+        std::vector<RGMemoryHeap> heaps;
+        std::vector<RGTimelineIntervals> heapIntervals;
+
+        for (const auto& [i, bucketResource] : std::views::enumerate(bucketResources))
+        {
+            auto& resource = generatedResources[i];
+            if (!resource.aliasable)
+            {
+                continue;
+            }
+
+            // Image and buffer heaps aren't compatible, heaps are only shared by resources of one type.
+            const auto heapIdx = *std::ranges::find_if(std::views::iota(size_t { 0 }, heaps.size() + 1), [&](const size_t h) {
+                return h == heaps.size() || (heaps[h].type == resource.type && heapIntervals[h].fits(bucketResource.intervals));
+            });
+            if (heapIdx == heaps.size())
+            {
+                heaps.push_back({ .id = IdSequence::next(), .type = resource.type });
+                heapIntervals.emplace_back();
+            }
+
+            heaps[heapIdx].size = std::max(heaps[heapIdx].size, resource.size);
+            heaps[heapIdx].resources.push_back(resource.id);
+            heapIntervals[heapIdx].insert(bucketResource.intervals);
+            resource.heap = heaps[heapIdx].id;
+        }
+
+        return heaps;
+    }
+
     std::vector<ResourceInfo> evaluateRequiredResources() const noexcept
     {
         std::vector<ResourceInfo> result;
 
-        // Get all output resources
+        // Pass ID -> Task index, passes without a task are placed after the last task
+        const auto taskCount = static_cast<int32_t>(mTasks.size());
+        std::unordered_map<Id_t, int32_t> taskIndexOfPass;
+        taskIndexOfPass.reserve(mTasks.size() * 2);
+        for (int32_t i = 0; i < taskCount; i++)
+        {
+            taskIndexOfPass.emplace(mTasks[i].pass->mId, i);
+            if (mTasks[i].asyncPass)
+            {
+                taskIndexOfPass.emplace(mTasks[i].asyncPass->mId, i);
+            }
+        }
+
+        // (Source Pass ID, Source Resource ID) -> Consumer edges
+        std::unordered_map<uint64_t, std::vector<const Edge*>> consumerEdges;
+        consumerEdges.reserve(mRenderGraph->mEdges.size());
+        for (const auto& edge : mRenderGraph->mEdges)
+        {
+            if (edge.src->mId != edge.dst->mId && edge.srcResource() && edge.dstResource())
+            {
+                consumerEdges[toEdgeKey(edge.src->mId, edge.srcResource()->id)].push_back(&edge);
+            }
+        }
+
+        // Get all output resources and their consumers
         for (const auto& node : mRenderGraph->mVertices)
         {
+            const auto nodeTask = taskIndexOfPass.find(node->mId);
+            const auto nodeIdx  = nodeTask == std::end(taskIndexOfPass) ? taskCount : nodeTask->second;
+
             for (auto& resource : node->dependencies | std::views::filter([](const Resource& res){ return res.access == AccessType::Write; }))
             {
-                const auto it = std::ranges::find_if(mTasks, [&](const RGTask& task){
-                    return task.pass->mId == node->mId
-                        || (task.asyncPass && task.asyncPass->mId == node->mId);
-                });
+                auto resourceInfo = ResourceInfo::createFrom(node.get(), resource, nodeIdx);
+
+                const auto edges = consumerEdges.find(toEdgeKey(node->mId, resource.id));
+                if (edges == std::end(consumerEdges))
+                {
+                    result.push_back(resourceInfo);
+                    continue;
+                }
+
+                for (const Edge* edge : edges->second)
+                {
+                    const auto consumerTask = taskIndexOfPass.find(edge->dst->mId);
+                    if (consumerTask == std::end(taskIndexOfPass))
+                    {
+                        continue;
+                    }
+
+                    ConsumerInfo consumerInfo = {
+                        .nodeId       = edge->dst->mId,
+                        .nodeIdx      = consumerTask->second,
+                        .nodeName     = edge->dst->name,
+                        .resourceId   = edge->dstResource()->id,
+                        .resourceName = edge->dstResource()->name,
+                        .access       = edge->dstResource()->access,
+                        .node         = edge->dst,
+                    };
+
+                    resourceInfo.consumers.push_back(consumerInfo);
+                }
+
+                result.push_back(resourceInfo);
+            }
+        }
+
+        return result;
+    }
+
+    static uint64_t toEdgeKey(const Id_t passId, const Id_t resourceId) noexcept
+    {
+        return static_cast<uint64_t>(static_cast<uint32_t>(passId)) << 32 | static_cast<uint32_t>(resourceId);
+    }
+
+    /**
+     * Compute the live-set curve of the aliasable resources. Lifetimes only alias within their alias class, so the
+     * sum of the per-class maxima is a lower bound for any allocation of them on this schedule.
+     * A gap to the allocated count points at the allocator, a high bound at the schedule or incompatible classes.
+     */
+    static void evaluateLowerBound(
+        RGResOptOutput&                                     output,
+        const std::vector<Lifetime>&                        lifetimes,
+        const std::map<RGAliasClass, std::vector<int32_t>>& buckets,
+        const int32_t                                       timelineLength)
+    {
+        output.liveSetCurve.assign(timelineLength, 0);
+        output.liveBytesCurve.assign(timelineLength, 0);
+        output.hasSizes = std::ranges::all_of(buckets | std::views::values | std::views::join, [&lifetimes](const int32_t idx) {
+            return lifetimes[idx].resource.size > 0;
+        });
+
+        std::vector<int32_t> classCurve(timelineLength, 0);
+        for (const auto& bucket : buckets | std::views::values)
+        {
+            std::ranges::fill(classCurve, 0);
+            for (const auto idx : bucket)
+            {
+                const auto& [resource, range] = lifetimes[idx];
+                for (int32_t t = std::max(range.start, 0); t <= range.end && t < timelineLength; t++)
+                {
+                    classCurve[t]++;
+                    output.liveSetCurve[t]++;
+                    output.liveBytesCurve[t] += resource.size;
+                }
+            }
+            output.lowerBound += classCurve.empty() ? 0 : std::ranges::max(classCurve);
+        }
+
+        const auto aliasedCount = output.postCount - output.nonOptimizables;
+        output.liveSetPeak   = output.liveSetCurve.empty() ? 0 : std::ranges::max(output.liveSetCurve);
+        output.optimalityGap = aliasedCount - output.lowerBound;
+
+        if (!output.hasSizes)
+        {
+            output.liveBytesCurve.clear();
+            return;
+        }
 
-                const auto i = static_cast<int32_t>(std::distance(std::begin(mTasks), it));
-                result.push_back(ResourceInfo::createFrom(node.get(), resource, i));
+        output.lowerBoundBytes = output.liveBytesCurve.empty() ? 0 : std::ranges::max(output.liveBytesCurve);
+        // Heaps are allocated once for all of their resources, aliasable resources outside of a heap on their own.
+        for (const auto& heap : output.heaps)
+        {
+            output.allocatedBytes += heap.size;
+        }
+        for (const auto& resource : output.generatedResources)
+        {
+            if (resource.aliasable && resource.heap == -1)
+            {
+                output.allocatedBytes += resource.size;
             }
         }
+        output.optimalityGapBytes = output.allocatedBytes - output.lowerBoundBytes;
+    }
 
-        // Find resource consumers
-        for (auto& resourceInfo : result)
+    /**
+     * Emit alloc / free events of the transient resources, aliasable resources placed into a heap are allocated as the heap.
+     * Resources excluded from aliasing get dedicated events, they may not share memory with any other resource.
+     * Arena offsets are assigned first-fit in event order, a block is reused once every event of its last task has been replayed.
+     */
+    static void evaluateMemoryEvents(RGResOptOutput& output)
+    {
+        // Physical ID -> Bytes, first and last task, dedicated
+        std::map<int32_t, std::tuple<uint64_t, int32_t, int32_t, bool>> allocations;
+        for (const auto& resource : output.generatedResources)
         {
-            for (const auto& edge : mRenderGraph->mEdges)
+            if (!isOptimizableResource(resource.type))
+            {
+                continue;
+            }
+
+            const auto range  = resource.getUsageRange();
+            const auto physId = resource.heap == -1 ? resource.id : resource.heap;
+            const auto [it, inserted] = allocations.try_emplace(physId, resource.size, range.start, range.end, !resource.aliasable);
+            if (!inserted)
             {
-                if (   resourceInfo.originNodeId         != edge.src->mId
-                    || resourceInfo.originNodeId         == edge.dst->mId
-                    || resourceInfo.originResource->id   != edge.pSrcRes->id
-                ) continue;
+                auto& [bytes, first, last, dedicated] = it->second;
+                bytes = std::max(bytes, resource.size);
+                first = std::min(first, range.start);
+                last  = std::max(last, range.end);
+            }
+        }
 
-                int32_t consumerNodeId     = edge.dst->mId;
-                const auto consumerResource = std::ranges::find_if(edge.dst->dependencies, [&](const Resource& res){
-                    return res.id == edge.pDstRes->id;
-                });
-                const int32_t consumerResourceId = consumerResource->id;
+        auto& events = output.memoryEvents;
+        for (const auto& [physId, allocation] : allocations)
+        {
+            const auto& [bytes, first, last, dedicated] = allocation;
+            events.push_back({ .taskIdx = first, .type = RGMemoryEventType::Alloc, .physId = physId, .bytes = bytes, .dedicated = dedicated });
+            events.push_back({ .taskIdx = last,  .type = RGMemoryEventType::Free,  .physId = physId, .bytes = bytes, .dedicated = dedicated });
+        }
+        std::ranges::stable_sort(events, {}, [](const RGMemoryEvent& event){ return std::pair { event.taskIdx, event.type }; });
 
-                const auto it = std::ranges::find_if(mTasks, [&](const RGTask& task){
-                    return task.pass->mId == consumerNodeId
-                        || (task.asyncPass && task.asyncPass->mId == consumerNodeId);
-                });
+        // Offset -> Bytes of the live blocks, Physical ID -> Offset
+        std::map<uint64_t, uint64_t> liveBlocks;
+        std::map<int32_t, uint64_t>  offsets;
+        for (auto& event : events)
+        {
+            if (event.dedicated)
+            {
+                continue;
+            }
 
-                const auto consumerNodeIdx = static_cast<int32_t>(std::distance(std::begin(mTasks), it));
-                Pass* consumerNode = it->pass->mId == consumerNodeId ? it->pass : it->asyncPass;
+            // Zero-byte allocations occupy no block, another live block may start at their offset.
+            if (event.type == RGMemoryEventType::Free)
+            {
+                event.offset = offsets.at(event.physId);
+                if (event.bytes > 0)
+                {
+                    liveBlocks.erase(event.offset);
+                }
+                continue;
+            }
 
-                ConsumerInfo consumerInfo = {
-                    .nodeId       = consumerNodeId,
-                    .nodeIdx      = consumerNodeIdx,
-                    .nodeName     = consumerNode->name,
-                    .resourceId   = consumerResourceId,
-                    .resourceName = edge.pDstRes->name,
-                    .access       = consumerResource->access,
-                    .node         = consumerNode,
-                };
+            uint64_t offset = 0;
+            for (const auto& [blockOffset, blockBytes] : liveBlocks)
+            {
+                if (offset + event.bytes <= blockOffset)
+                {
+                    break;
+                }
+                offset = std::max(offset, blockOffset + blockBytes);
+            }
 
-                resourceInfo.consumers.push_back(consumerInfo);
+            event.offset = offset;
+            offsets[event.physId] = offset;
+            if (event.bytes > 0)
+            {
+                liveBlocks.emplace(offset, event.bytes);
             }
+            output.transientArenaSize = std::max(output.transientArenaSize, offset + event.bytes);
         }
+    }
 
-        return result;
+    static std::unordered_map<Id_t, std::string> getNames(const std::vector<ResourceInfo>& resourceInfos)
+    {
+        std::unordered_map<Id_t, std::string> names;
+        for (const auto& resourceInfo : resourceInfos)
+        {
+            names.try_emplace(resourceInfo.originNodeId, resourceInfo.originNode->name);
+            names.try_emplace(resourceInfo.originResourceId, resourceInfo.originResource->name);
+            for (const auto& consumer : resourceInfo.consumers)
+            {
+                names.try_emplace(consumer.nodeId, consumer.nodeName);
+                names.try_emplace(consumer.resourceId, consumer.resourceName);
+            }
+        }
+        return names;
     }
 
-    static std::set<UsagePoint> getUsagePointsForResourceInfo(const ResourceInfo& resourceInfo)
+    static UsagePointList getUsagePointsForResourceInfo(const ResourceInfo& resourceInfo)
     {
-        std::set<UsagePoint> usagePoints;
+        UsagePointList usagePoints;
 
         const UsagePoint producerUsagePoint(resourceInfo);
         usagePoints.insert(producerUsagePoint);
@@ -160,4 +523,6 @@ private:
 
     const RenderGraph*         mRenderGraph;
     const std::vector<RGTask>& mTasks;
+    const std::set<Id_t>       mPinnedResources;
+    const bool                 mHeapAliasing;
 };
@@ -1,11 +1,18 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
 #include <cstdint>
 #include <format>
+#include <initializer_list>
+#include <optional>
 #include <ranges>
 #include <set>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 #include "../InputData.h"
 
@@ -15,9 +22,40 @@
 
 constexpr bool isOptimizableResource(const ResourceType resourceType)
 {
-    return resourceType == ResourceType::Image;
+    return resourceType == ResourceType::Image || resourceType == ResourceType::Buffer;
 }
 
+/**
+ * Resources are only aliased with resources of the same class.
+ * Images and buffers are kept apart, as their heaps aren't compatible,
+ * images are further bucketed by their compatibility key, so aliased images can share one physical image,
+ * buffers by their power-of-two size class. Buffers of unknown size have no class and are not aliased.
+ */
+struct RGAliasClass
+{
+    ResourceType             type      = ResourceType::Unknown;
+    uint64_t                 sizeClass = 0;
+    ResourceCompatibilityKey compatibility;
+
+    auto operator<=>(const RGAliasClass&) const = default;
+
+    /** @return Whether the resource can be placed into an alias class. */
+    static bool isAliasable(const Resource& resource)
+    {
+        return resource.type != ResourceType::Buffer || resource.desc.size > 0;
+    }
+
+    static RGAliasClass of(const Resource& resource)
+    {
+        const bool isBuffer = resource.type == ResourceType::Buffer;
+        return {
+            .type          = resource.type,
+            .sizeClass     = isBuffer && resource.desc.size > 0 ? std::bit_ceil(resource.desc.size) : 0,
+            .compatibility = isBuffer ? ResourceCompatibilityKey {} : resource.desc.compatibility,
+        };
+    }
+};
+
 struct ConsumerInfo
 {
     Id_t        nodeId     = rgInvalidId;
@@ -57,39 +95,37 @@ struct ResourceInfo
     }
 };
 
+/**
+ * Usage of a resource by a task.
+ * Names of the using node and resource are resolved through RGResOptOutput::nameOf.
+ */
 struct UsagePoint
 {
-    int32_t     point      = {};
-    int32_t     userResId  = rgInvalidId;
-    std::string usedAs;
-    int32_t     userNodeId = rgInvalidId;
-    std::string usedBy;
+    int32_t     point      = {};    // Task index
+    Id_t        userResId  = rgInvalidId;
+    Id_t        userNodeId = rgInvalidId;
     AccessType  access     = AccessType::None;
 
     UsagePoint() = default;
 
     explicit UsagePoint(const ConsumerInfo& consumerInfo)
+    : point(consumerInfo.nodeIdx)
+    , userResId(consumerInfo.resourceId)
+    , userNodeId(consumerInfo.nodeId)
+    , access(consumerInfo.access)
     {
-        point      = consumerInfo.nodeIdx;
-        userResId  = consumerInfo.resourceId;
-        usedAs     = consumerInfo.resourceName;
-        userNodeId = consumerInfo.nodeId;
-        usedBy     = consumerInfo.nodeName;
-        access     = consumerInfo.access;
     }
 
     explicit UsagePoint(const ResourceInfo& resourceInfo)
+    : point(resourceInfo.originNodeIdx)
+    , userResId(resourceInfo.originResourceId)
+    , userNodeId(resourceInfo.originNodeId)
+    , access(resourceInfo.originResource->access)
     {
-        point      = resourceInfo.originNodeIdx;
-        userResId  = resourceInfo.originResourceId;
-        usedAs     = resourceInfo.originResource->name;
-        userNodeId = resourceInfo.originNodeId;
-        usedBy     = resourceInfo.originNode->name;
-        access     = resourceInfo.originResource->access;
     }
 };
 #ifdef rg_JSON_EXPORT
-NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(UsagePoint, point, userResId, usedAs, userNodeId, usedBy, access);
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(UsagePoint, point, userResId, userNodeId, access);
 #endif
 
 inline bool operator<(const UsagePoint& lhs, const UsagePoint& rhs)
@@ -102,6 +138,129 @@ inline bool operator==(const UsagePoint& lhs, const UsagePoint& rhs)
     return lhs.point == rhs.point;
 }
 
+/**
+ * Set of usage points ordered and unique by point, stored in a contiguous array.
+ * Small lists live inline, only lists longer than <InlineCapacity> allocate.
+ */
+class UsagePointList
+{
+public:
+    static constexpr size_t InlineCapacity = 6;
+
+    using const_iterator = const UsagePoint*;
+
+    UsagePointList() = default;
+
+    UsagePointList(std::initializer_list<UsagePoint> points)
+    {
+        for (const auto& point : points)
+        {
+            insert(point);
+        }
+    }
+
+    /** @return False if the point is already occupied. */
+    bool insert(const UsagePoint& usagePoint)
+    {
+        const auto it = std::lower_bound(begin(), end(), usagePoint);
+        if (it != end() && *it == usagePoint)
+        {
+            return false;
+        }
+
+        const auto idx = static_cast<size_t>(it - begin());
+        grow(mSize + 1);
+
+        UsagePoint* points = data();
+        std::copy_backward(points + idx, points + mSize, points + mSize + 1);
+        points[idx] = usagePoint;
+        mSize++;
+
+        return true;
+    }
+
+    /** @return Whether any point of <other> is occupied in this list. */
+    bool intersects(const UsagePointList& other) const noexcept
+    {
+        auto a = begin();
+        auto b = other.begin();
+        while (a != end() && b != other.end())
+        {
+            if (*a == *b) return true;
+            if (*a < *b) ++a; else ++b;
+        }
+        return false;
+    }
+
+    /** Merge the points of a non-intersecting list into this one. */
+    void merge(const UsagePointList& other)
+    {
+        grow(mSize + other.mSize);
+
+        // Merge from the back so no temporary storage is needed.
+        UsagePoint* points = data();
+        size_t      i      = mSize;
+        size_t      j      = other.mSize;
+        size_t      k      = mSize + other.mSize;
+        while (j > 0)
+        {
+            if (i > 0 && other.data()[j - 1] < points[i - 1])
+            {
+                points[--k] = points[--i];
+            }
+            else
+            {
+                points[--k] = other.data()[--j];
+            }
+        }
+        mSize += other.mSize;
+    }
+
+    /** @return Whether the list contains a usage by the given task. */
+    bool contains(const int32_t point) const noexcept
+    {
+        return find(point) != end();
+    }
+
+    /** @return First usage by the given task. */
+    const_iterator find(const int32_t point) const noexcept
+    {
+        const auto it = std::lower_bound(begin(), end(), point, [](const UsagePoint& up, const int32_t value){ return up.point < value; });
+        return (it != end() && it->point == point) ? it : end();
+    }
+
+    const UsagePoint& front() const { return data()[0]; }
+    const UsagePoint& back()  const { return data()[mSize - 1]; }
+
+    size_t size()  const noexcept { return mSize; }
+    bool   empty() const noexcept { return mSize == 0; }
+
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end()   const noexcept { return data() + mSize; }
+
+private:
+    UsagePoint*       data()       noexcept { return mHeap.empty() ? mInline.data() : mHeap.data(); }
+    const UsagePoint* data() const noexcept { return mHeap.empty() ? mInline.data() : mHeap.data(); }
+
+    void grow(const size_t capacity)
+    {
+        if (capacity <= InlineCapacity || capacity <= mHeap.size())
+        {
+            return;
+        }
+
+        if (mHeap.empty())
+        {
+            mHeap.assign(std::begin(mInline), std::begin(mInline) + mSize);
+        }
+        mHeap.resize(std::max(capacity, mHeap.size() * 2));
+    }
+
+    std::array<UsagePoint, InlineCapacity> mInline = {};
+    std::vector<UsagePoint>                mHeap;
+    size_t                                 mSize = 0;
+};
+
 struct Range
 {
     int32_t start;
@@ -109,15 +268,10 @@ struct Range
 
     Range() = default;
 
-    explicit Range(const std::set<UsagePoint>& points)
+    explicit Range(const UsagePointList& points)
+    : start(points.front().point)
+    , end(points.back().point)
     {
-        const auto min = std::min_element(std::begin(points), std::end(points));
-        const auto max = std::max_element(std::begin(points), std::end(points));
-
-        start = min->point;
-        end = max->point;
-
-        validate();
     }
 
     Range(const int32_t a, const int32_t b): start(a), end(b)
@@ -143,10 +297,14 @@ private:
 struct RGOptResource
 {
     int32_t              id;
-    std::set<UsagePoint> usagePoints;
+    UsagePointList       usagePoints;
     Resource             originalResource;
     Id_t                 originalNode;
     ResourceType         type;
+    uint64_t             size      = 0;     // Largest size of the resources aliased into this one
+    RGAliasClass         aliasClass;
+    bool                 aliasable = true;  // False if the resource was excluded from optimization
+    int32_t              heap      = -1;    // ID of the memory heap the resource is placed into, -1 if allocated dedicated
 
     Range getUsageRange() const
     {
@@ -155,35 +313,81 @@ struct RGOptResource
 
     std::optional<UsagePoint> getUsagePoint(const int32_t value) const
     {
-        const auto find = std::ranges::find_if(usagePoints, [&](const UsagePoint& up){ return up.point == value; });
+        const auto find = usagePoints.find(value);
         return (find == std::end(usagePoints))
             ? std::nullopt
             : std::make_optional(*find);
     }
 
-    bool insertUsagePoints(const std::set<UsagePoint>& points)
+    bool insertUsagePoints(const UsagePointList& points)
     {
         // Validation for occupied usage points
-        std::vector<UsagePoint> intersection;
-        std::set_intersection(std::begin(usagePoints), std::end(usagePoints), std::begin(points), std::end(points), std::back_inserter(intersection));
-
-        if (!intersection.empty())
+        if (usagePoints.intersects(points))
         {
             return false;
         }
 
-        for (const auto& point: points)
-        {
-            usagePoints.insert(point);
-        }
-
+        usagePoints.merge(points);
         return true;
     }
 };
 
+/**
+ * Memory shared by generated resources of different alias classes with disjoint lifetimes.
+ * Each resource is placed at the start of the heap, they can only be aliased at memory level.
+ * A heap holds either images or buffers.
+ */
+struct RGMemoryHeap
+{
+    int32_t              id;
+    ResourceType         type = ResourceType::Unknown;
+    uint64_t             size = 0;      // Largest size of the placed resources
+    std::vector<int32_t> resources;     // IDs of the placed generated resources
+};
+
+enum class RGMemoryEventType
+{
+    Alloc,
+    Free,
+};
+constexpr std::string toString(const RGMemoryEventType type) noexcept
+{
+    using enum RGMemoryEventType;
+    switch (type)
+    {
+        case Alloc : return "alloc";
+        case Free  : return "free";
+    }
+    return std::string(rgUnknownEnumStr);
+}
+
+/**
+ * Allocation of a physical resource from the transient arena of a frame, or a dedicated one outside of it.
+ * Allocations happen before <taskIdx> is executed, frees after it.
+ */
+struct RGMemoryEvent
+{
+    int32_t           taskIdx   = -1;
+    RGMemoryEventType type      = RGMemoryEventType::Alloc;
+    int32_t           physId    = -1;       // ID of the generated resource, or of its heap if placed into one
+    uint64_t          bytes     = 0;
+    uint64_t          offset    = 0;        // Offset in the transient arena
+    bool              dedicated = false;    // Excluded from aliasing, allocated on its own outside the arena
+};
+
 struct RGResOptOutput
 {
     std::vector<RGOptResource>  generatedResources;
+    std::vector<RGMemoryHeap>   heaps;
+
+    // Pass and Resource ID -> Name, IDs are unique across both.
+    std::unordered_map<Id_t, std::string> names;
+
+    std::string_view nameOf(const Id_t id) const
+    {
+        const auto it = names.find(id);
+        return it == std::end(names) ? rgUnknownEnumStr : std::string_view(it->second);
+    }
 
     // Input
     std::vector<Resource>       originalResources;
@@ -194,4 +398,22 @@ struct RGResOptOutput
     int32_t preCount        = 0;
     int32_t postCount       = 0;
     Range   timelineRange   = { 0, 0 };
+
+    // Optimality : Sum of the max overlap of aliasable lifetimes per alias class, no allocation can use fewer resources.
+    std::vector<int32_t>  liveSetCurve;                 // Live aliasable resources per task index, across all classes
+    int32_t               liveSetPeak           = 0;    // Max of <liveSetCurve>, the bound if every class could alias
+    int32_t               lowerBound            = 0;
+    int32_t               optimalityGap         = 0;    // Aliasable resources allocated above the lower bound
+
+    // Byte statistics are only valid if every aliasable resource has a known size.
+    bool                  hasSizes              = false;
+    std::vector<uint64_t> liveBytesCurve;
+    uint64_t              lowerBoundBytes       = 0;
+    uint64_t              allocatedBytes        = 0;    // Merged heap sizes plus the aliasable resources outside of a heap
+    uint64_t              optimalityGapBytes    = 0;
+
+    // Transient arena : Time-ordered alloc / free events of the transient resources, for replay by a linear suballocator.
+    // Aliasable resources are placed into the arena, the ones excluded from aliasing get dedicated events.
+    std::vector<RGMemoryEvent> memoryEvents;
+    uint64_t                   transientArenaSize = 0;
 };
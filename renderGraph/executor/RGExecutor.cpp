@@ -0,0 +1,202 @@
+#include "RGExecutor.h"
+
+#include <algorithm>
+#include <map>
+
+#include "../RenderGraph.h"
+#include "../compiler/RGCompilerTypes.h"
+
+RGExecutor::RGExecutor(const RenderGraph& renderGraph, const RGCompilerOutput& output, RGPassCallback fallback, uint32_t workerCount)
+: mFallback(std::move(fallback))
+{
+    if (!output.hasFailed && output.phaseOutputs.has_value())
+    {
+        const auto& order = output.phaseOutputs->serialExecutionOrder;
+
+        std::map<Id_t, uint32_t> indexOf;
+        for (const auto passId : order)
+        {
+            const Pass* pass = renderGraph.getPassById(passId);
+            indexOf.emplace(passId, static_cast<uint32_t>(mPasses.size()));
+            if (pass->flags.sentinel && pass->name == rgPresentPass)
+            {
+                mPresentIdx = static_cast<uint32_t>(mPasses.size());
+            }
+            mPasses.push_back(pass);
+        }
+
+        // Successor lists as CSR, counted first and then filled.
+        const auto& edges = output.phaseOutputs->transitiveReduction;
+        mDependencyCounts.resize(mPasses.size(), 0);
+        mSuccessors.offsets.assign(mPasses.size() + 1, 0);
+        for (const auto& [src, dst] : edges)
+        {
+            mSuccessors.offsets[indexOf.at(src) + 1]++;
+            mDependencyCounts[indexOf.at(dst)]++;
+        }
+        for (size_t i = 0; i < mPasses.size(); i++)
+        {
+            mSuccessors.offsets[i + 1] += mSuccessors.offsets[i];
+        }
+
+        std::vector<uint32_t> fill(std::begin(mSuccessors.offsets), std::end(mSuccessors.offsets) - 1);
+        mSuccessors.targets.resize(edges.size());
+        for (const auto& [src, dst] : edges)
+        {
+            mSuccessors.targets[fill[indexOf.at(src)]++] = indexOf.at(dst);
+        }
+    }
+
+    mPooledCount = static_cast<uint32_t>(mPasses.size()) - (mPresentIdx != UINT32_MAX ? 1 : 0);
+    mPending = std::vector<std::atomic<int32_t>>(mPasses.size());
+
+    workerCount = workerCount != 0 ? workerCount : std::max(std::thread::hardware_concurrency(), 1u);
+    for (uint32_t i = 0; i < workerCount; i++)
+    {
+        mWorkers.push_back(std::make_unique<Worker>());
+    }
+    for (uint32_t i = 0; i < workerCount; i++)
+    {
+        mThreads.emplace_back([this, i]{ workerLoop(i); });
+    }
+}
+
+RGExecutor::~RGExecutor()
+{
+    mStop.store(true, std::memory_order_relaxed);
+    mRunGeneration.fetch_add(1, std::memory_order_release);
+    mRunGeneration.notify_all();
+}
+
+void RGExecutor::run()
+{
+    if (mPooledCount > 0)
+    {
+        for (size_t i = 0; i < mPasses.size(); i++)
+        {
+            mPending[i].store(mDependencyCounts[i], std::memory_order_relaxed);
+        }
+
+        // Seed the passes without dependencies round-robin.
+        uint32_t nextWorker = 0;
+        for (uint32_t i = 0; i < mPasses.size(); i++)
+        {
+            if (mDependencyCounts[i] == 0 && i != mPresentIdx)
+            {
+                push(nextWorker, i);
+                nextWorker = (nextWorker + 1) % workerCount();
+            }
+        }
+
+        mRemaining.store(mPooledCount, std::memory_order_release);
+        mRunGeneration.fetch_add(1, std::memory_order_release);
+        mRunGeneration.notify_all();
+
+        for (uint32_t remaining = mRemaining.load(std::memory_order_acquire); remaining != 0; remaining = mRemaining.load(std::memory_order_acquire))
+        {
+            mRemaining.wait(remaining, std::memory_order_acquire);
+        }
+    }
+
+    // Final join
+    if (mPresentIdx != UINT32_MAX)
+    {
+        invoke(mPresentIdx);
+    }
+}
+
+void RGExecutor::workerLoop(const uint32_t workerIdx)
+{
+    uint64_t seenGeneration = 0;
+    while (true)
+    {
+        mRunGeneration.wait(seenGeneration, std::memory_order_acquire);
+        seenGeneration = mRunGeneration.load(std::memory_order_acquire);
+        if (mStop.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+
+        while (mRemaining.load(std::memory_order_acquire) != 0)
+        {
+            uint32_t task;
+            if (pop(workerIdx, task) || steal(workerIdx, task))
+            {
+                execute(workerIdx, task);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+bool RGExecutor::pop(const uint32_t workerIdx, uint32_t& task)
+{
+    auto& worker = *mWorkers[workerIdx];
+    const std::scoped_lock lock(worker.mutex);
+    if (worker.tasks.empty())
+    {
+        return false;
+    }
+
+    task = worker.tasks.back();
+    worker.tasks.pop_back();
+    return true;
+}
+
+bool RGExecutor::steal(const uint32_t workerIdx, uint32_t& task)
+{
+    for (uint32_t i = 1; i < workerCount(); i++)
+    {
+        auto& victim = *mWorkers[(workerIdx + i) % workerCount()];
+        const std::scoped_lock lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            mSteals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void RGExecutor::push(const uint32_t workerIdx, const uint32_t task)
+{
+    auto& worker = *mWorkers[workerIdx];
+    const std::scoped_lock lock(worker.mutex);
+    worker.tasks.push_back(task);
+}
+
+void RGExecutor::execute(const uint32_t workerIdx, const uint32_t task)
+{
+    invoke(task);
+
+    for (const uint32_t successor : mSuccessors.successors(task))
+    {
+        if (successor != mPresentIdx && mPending[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            push(workerIdx, successor);
+        }
+    }
+
+    if (mRemaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        mRemaining.notify_all();
+    }
+}
+
+void RGExecutor::invoke(const uint32_t task) const
+{
+    const Pass& pass = *mPasses[task];
+    if (pass.execute)
+    {
+        pass.execute(pass);
+    }
+    else if (mFallback)
+    {
+        mFallback(pass);
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../Graph.h"
+#include "../RenderGraphCore.h"
+
+class RenderGraph;
+struct RGCompilerOutput;
+
+// =======================================
+// Executor : Backends
+// =======================================
+using RGPassCallback = std::function<void(const Pass&)>;
+
+/** Stand-in for command recording, busy-waits <cost> per pass. A cost of 0 makes it a no-op backend. */
+struct RGSimulatedBackend
+{
+    std::chrono::nanoseconds cost { 0 };
+
+    void operator()(const Pass&) const
+    {
+        const auto end = std::chrono::steady_clock::now() + cost;
+        while (std::chrono::steady_clock::now() < end)
+        {
+        }
+    }
+};
+
+// =======================================
+// Executor
+// =======================================
+
+/**
+ * Runs the passes of a compiled graph on a work-stealing thread pool.
+ * Dependencies are the edges of the transitive reduction, each pass has an atomic counter of unfinished
+ * dependencies and is pushed to the deque of the worker which finished its last dependency.
+ * Workers pop their own deque LIFO and steal FIFO from the others when it's empty.
+ * The Present pass is not scheduled, it runs on the calling thread once all other passes have finished.
+ */
+class RGExecutor
+{
+public:
+    /**
+     * @param fallback Invoked for passes without an execute callback, may be empty.
+     * @param workerCount Number of worker threads, 0 to use one per hardware thread.
+     */
+    RGExecutor(const RenderGraph& renderGraph, const RGCompilerOutput& output, RGPassCallback fallback = {}, uint32_t workerCount = 0);
+    ~RGExecutor();
+
+    RGExecutor(const RGExecutor&) = delete;
+    RGExecutor& operator=(const RGExecutor&) = delete;
+
+    /** Execute every pass once and block until Present has executed. Callbacks must not throw. */
+    void run();
+
+    uint32_t workerCount() const noexcept { return static_cast<uint32_t>(mWorkers.size()); }
+
+    /** @return Number of passes taken from another worker's deque since construction. */
+    uint64_t stealCount() const noexcept { return mSteals.load(std::memory_order_relaxed); }
+
+private:
+    struct Worker
+    {
+        std::mutex           mutex;
+        std::deque<uint32_t> tasks;     // Pass indices
+    };
+
+    void workerLoop(uint32_t workerIdx);
+
+    bool pop(uint32_t workerIdx, uint32_t& task);
+    bool steal(uint32_t workerIdx, uint32_t& task);
+    void push(uint32_t workerIdx, uint32_t task);
+
+    /** Execute a pass and release its successors, the last finished pass wakes run(). */
+    void execute(uint32_t workerIdx, uint32_t task);
+
+    void invoke(uint32_t task) const;
+
+    // Graph : Passes in serial execution order
+    std::vector<const Pass*>  mPasses;
+    CSRGraph                  mSuccessors;
+    std::vector<int32_t>      mDependencyCounts;
+    uint32_t                  mPresentIdx  = UINT32_MAX;
+    uint32_t                  mPooledCount = 0;     // Passes run by the workers, all except Present
+    RGPassCallback            mFallback;
+
+    // Run state
+    std::vector<std::atomic<int32_t>> mPending;
+    std::atomic<uint32_t>             mRemaining     { 0 };
+    std::atomic<uint64_t>             mRunGeneration { 0 };
+    std::atomic<bool>                 mStop          { false };
+    std::atomic<uint64_t>             mSteals        { 0 };
+
+    std::vector<std::unique_ptr<Worker>> mWorkers;
+    std::vector<std::jthread>            mThreads;
+};
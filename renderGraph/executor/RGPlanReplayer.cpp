@@ -0,0 +1,83 @@
+#include "RGPlanReplayer.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#include "../RenderGraph.h"
+
+RGPlanReplayer::RGPlanReplayer(const RenderGraph& renderGraph, const RGExecutionPlanView plan, RGPassCallback fallback)
+: mPlan(plan)
+, mFallback(std::move(fallback))
+{
+    if (!mPlan.isValid())
+    {
+        return;
+    }
+
+    const auto passCount = mPlan.header().passCount;
+    mPasses.reserve(passCount);
+    for (uint32_t i = 0; i < passCount; i++)
+    {
+        const Pass* pass = renderGraph.getPassById(mPlan.passId(i));
+        if (!pass)
+        {
+            mPasses.clear();
+            return;
+        }
+        mPasses.push_back(pass);
+    }
+
+    mValid = true;
+}
+
+RGPlanReplayStats RGPlanReplayer::run() const
+{
+    RGPlanReplayStats stats;
+    if (!mValid)
+    {
+        return stats;
+    }
+
+    mPlan.execute([&]<class Record>(const Record& record) {
+        if constexpr (std::is_same_v<Record, RGPlanSubmit>)
+        {
+            invoke(record.passIdx);
+            stats.submits++;
+        }
+        else if constexpr (std::is_same_v<Record, RGPlanWait>)
+        {
+            stats.waits++;
+        }
+        else if constexpr (std::is_same_v<Record, RGPlanOwnershipTransfer>)
+        {
+            stats.ownershipTransfers++;
+        }
+        else if constexpr (std::is_same_v<Record, RGPlanAlloc>)
+        {
+            stats.allocations++;
+            if (record.dedicated)
+            {
+                stats.dedicatedBytes += record.bytes;
+            }
+            else
+            {
+                stats.arenaHighWater = std::max(stats.arenaHighWater, record.offset + record.bytes);
+            }
+        }
+    });
+
+    return stats;
+}
+
+void RGPlanReplayer::invoke(const uint32_t passIdx) const
+{
+    const Pass& pass = *mPasses[passIdx];
+    if (pass.execute)
+    {
+        pass.execute(pass);
+    }
+    else if (mFallback)
+    {
+        mFallback(pass);
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "RGExecutor.h"
+#include "../compiler/RGExecutionPlan.h"
+
+class RenderGraph;
+
+/** Records replayed by one run of a plan. */
+struct RGPlanReplayStats
+{
+    uint32_t submits            = 0;
+    uint32_t waits              = 0;
+    uint32_t ownershipTransfers = 0;
+    uint32_t allocations        = 0;
+    uint64_t arenaHighWater     = 0;    // Highest end of a live arena allocation, at most the plan's transient arena size
+    uint64_t dedicatedBytes     = 0;    // Bytes of the dedicated allocations
+};
+
+/**
+ * Replays a flat execution plan on the calling thread, in one linear walk over its records.
+ * Pass table indices are resolved to passes once on construction, a replay does not allocate or look up passes.
+ * Waits, ownership transfers and allocations are only counted, there is no GPU backend to forward them to.
+ * The plan bytes, e.g. a compiler output or a mapped plan cache file, have to outlive the replayer.
+ */
+class RGPlanReplayer
+{
+public:
+    /** @param fallback Invoked for passes without an execute callback, may be empty. */
+    RGPlanReplayer(const RenderGraph& renderGraph, RGExecutionPlanView plan, RGPassCallback fallback = {});
+
+    /** @return Whether the plan is valid and every pass of its pass table exists in the graph. */
+    bool isValid() const noexcept { return mValid; }
+
+    /** Replay every record of the plan once, does nothing if the plan isn't valid. */
+    RGPlanReplayStats run() const;
+
+private:
+    void invoke(uint32_t passIdx) const;
+
+    RGExecutionPlanView      mPlan;
+    std::vector<const Pass*> mPasses;   // Pass table index -> Pass
+    RGPassCallback           mFallback;
+    bool                     mValid = false;
+};
@@ -0,0 +1,180 @@
+#include "JSONWriter.h"
+
+#include <charconv>
+
+JSONWriter::JSONWriter(std::FILE* file, const bool compact)
+: mFile(file)
+, mCompact(compact)
+{
+    mBuffer.reserve(FlushThreshold + 1024);
+}
+
+JSONWriter::~JSONWriter()
+{
+    flush();
+}
+
+void JSONWriter::beginObject()
+{
+    beginElement();
+    write('{');
+    mEmpty.push_back(true);
+}
+
+void JSONWriter::endObject()
+{
+    endContainer('}');
+}
+
+void JSONWriter::beginArray()
+{
+    beginElement();
+    write('[');
+    mEmpty.push_back(true);
+}
+
+void JSONWriter::endArray()
+{
+    endContainer(']');
+}
+
+void JSONWriter::key(const std::string_view name)
+{
+    beginElement();
+    writeString(name);
+    write(mCompact ? ":" : ": ");
+    mAfterKey = true;
+}
+
+void JSONWriter::value(const std::string_view str)
+{
+    beginElement();
+    writeString(str);
+}
+
+void JSONWriter::writeString(const std::string_view str)
+{
+    write('"');
+    for (const char c : str)
+    {
+        switch (c)
+        {
+            case '"'  : write("\\\""); break;
+            case '\\' : write("\\\\"); break;
+            case '\b' : write("\\b");  break;
+            case '\f' : write("\\f");  break;
+            case '\n' : write("\\n");  break;
+            case '\r' : write("\\r");  break;
+            case '\t' : write("\\t");  break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    constexpr std::string_view hex = "0123456789abcdef";
+                    write("\\u00");
+                    write(hex[c >> 4]);
+                    write(hex[c & 0xF]);
+                }
+                else
+                {
+                    write(c);
+                }
+        }
+    }
+    write('"');
+}
+
+void JSONWriter::value(const int64_t number)
+{
+    beginElement();
+    char digits[24];
+    const auto [end, ec] = std::to_chars(std::begin(digits), std::end(digits), number);
+    write(std::string_view(digits, end));
+}
+
+void JSONWriter::value(const uint64_t number)
+{
+    beginElement();
+    char digits[24];
+    const auto [end, ec] = std::to_chars(std::begin(digits), std::end(digits), number);
+    write(std::string_view(digits, end));
+}
+
+void JSONWriter::value(const bool boolean)
+{
+    beginElement();
+    write(boolean ? "true" : "false");
+}
+
+void JSONWriter::flush()
+{
+    if (!mBuffer.empty())
+    {
+        std::fwrite(mBuffer.data(), 1, mBuffer.size(), mFile);
+        mBuffer.clear();
+    }
+    std::fflush(mFile);
+}
+
+void JSONWriter::beginElement()
+{
+    // Values following a key belong to it.
+    if (mAfterKey)
+    {
+        mAfterKey = false;
+        return;
+    }
+
+    if (mEmpty.empty())
+    {
+        return;
+    }
+
+    if (!mEmpty.back())
+    {
+        write(',');
+    }
+    mEmpty.back() = false;
+    newLine();
+}
+
+void JSONWriter::endContainer(const char bracket)
+{
+    const bool empty = mEmpty.back();
+    mEmpty.pop_back();
+    if (!empty)
+    {
+        newLine();
+    }
+    write(bracket);
+
+    if (mEmpty.empty())
+    {
+        write(mCompact ? "" : "\n");
+    }
+}
+
+void JSONWriter::newLine()
+{
+    if (mCompact)
+    {
+        return;
+    }
+
+    write('\n');
+    mBuffer.append(mEmpty.size() * 4, ' ');
+}
+
+void JSONWriter::write(const std::string_view str)
+{
+    mBuffer.append(str);
+    if (mBuffer.size() >= FlushThreshold)
+    {
+        std::fwrite(mBuffer.data(), 1, mBuffer.size(), mFile);
+        mBuffer.clear();
+    }
+}
+
+void JSONWriter::write(const char c)
+{
+    write(std::string_view(&c, 1));
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Streaming JSON writer without an intermediate document.
+ * Output is buffered and flushed to the file in blocks, pretty output is indented by 4 spaces.
+ */
+class JSONWriter
+{
+public:
+    JSONWriter(std::FILE* file, bool compact);
+    ~JSONWriter();
+
+    JSONWriter(const JSONWriter&) = delete;
+    JSONWriter& operator=(const JSONWriter&) = delete;
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    void key(std::string_view name);
+
+    void value(std::string_view str);
+    void value(const char* str) { value(std::string_view(str)); }
+    void value(int64_t number);
+    void value(int32_t number) { value(static_cast<int64_t>(number)); }
+    void value(uint64_t number);
+    void value(bool boolean);
+
+    template <class T>
+    void field(const std::string_view name, const T& fieldValue)
+    {
+        key(name);
+        value(fieldValue);
+    }
+
+    void flush();
+
+private:
+    /** Separator and indentation before a new array element or object key. */
+    void beginElement();
+    void endContainer(char bracket);
+    void writeString(std::string_view str);
+    void newLine();
+    void write(std::string_view str);
+    void write(char c);
+
+    static constexpr size_t FlushThreshold = 64 * 1024;
+
+    std::FILE*        mFile;
+    bool              mCompact;
+    bool              mAfterKey = false;
+    std::vector<bool> mEmpty;      // Per open container, whether it has no elements yet
+    std::string       mBuffer;
+};
@@ -1,132 +1,198 @@
 #include "RGCompilerExport.h"
 
 #include <chrono>
+#include <cstdio>
 #include <filesystem>
 #include <fstream>
 #include <ranges>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #include "../RenderGraph.h"
 #include "../compiler/RGCompilerTypes.h"
 
-#ifdef rg_JSON_EXPORT
-    #include <nlohmann/json.hpp>
-#endif
+#include "JSONWriter.h"
 
-void RenderGraphCompilerExport::exportJSONCompilerOutput(const RGCompilerOutput& output, const RenderGraph* renderGraph)
+void RenderGraphCompilerExport::exportJSONCompilerOutput(const RGCompilerOutput& output, const RenderGraph* renderGraph, const bool compact)
 {
-#ifdef rg_JSON_EXPORT
     if (!output.phaseOutputs.has_value())
     {
         return;
     }
 
-    const auto results = output.phaseOutputs.value();
-
-    using namespace nlohmann;
-    json graphExport = {
-        { "compilerOptions", {
-            { "allowParallelization", output.options.allowParallelization },
-        }},
-        { "inputGraph", {
-            { "nodes", json::array() },
-            { "edges", json::array() },
-        }},
-        { "serialExecutionOrder", json::array() },
-        { "parallelizableNodes", json::array() },
-        {"generatedTasks", json::array() },
-        { "resourceOptimizerResult", {
-            { "timelineLength", results.resourceOptimizer.timelineRange.end },
-            { "preCount", results.resourceOptimizer.preCount },
-            { "postCount", results.resourceOptimizer.postCount },
-            { "reduction", results.resourceOptimizer.reduction },
-            { "resources", json::array() },
-        }}
-    };
+    const auto& results = output.phaseOutputs.value();
 
-    // graphExport["inputGraph"]["nodes"]
-    for (const auto& [i, node] : std::views::enumerate(renderGraph->mVertices))
+    std::unordered_map<Id_t, std::string_view> passNames;
+    passNames.reserve(renderGraph->mVertices.size());
+    for (const auto& node : renderGraph->mVertices)
     {
-        graphExport["inputGraph"]["nodes"].push_back({
-            { "id", node->mId },
-            {"name", node->name },
-            { "dependencies", json::array() },
-        });
-        for (const auto& resource : node->dependencies)
-        {
-            graphExport["inputGraph"]["nodes"][i]["dependencies"].push_back({
-                { "id", resource.id },
-                { "name", resource.name },
-                { "type", resource.type },
-                { "access", resource.access },
-            });
-        }
+        passNames.emplace(node->mId, node->name);
     }
 
-    // graphExport["inputGraph"]["edges"]
-    for (const auto& edge : renderGraph->mEdges)
+    if (!std::filesystem::exists("export"))
     {
-        graphExport["inputGraph"]["edges"].push_back({
-            { "id", edge.id },
-            { "srcNodeId", edge.src->mId },
-            { "srcRes", edge.srcRes },
-            { "dstNodeId", edge.dst->mId },
-            { "dstRes", edge.dstRes },
-        });
+        std::filesystem::create_directory("export");
     }
-
-    // graphExport["serialExecutionOrder"]
-    for (const auto& node : renderGraph->toNodePtrList(results.serialExecutionOrder))
+    std::FILE* file = std::fopen("export/graphExport.json", "wb");
+    if (!file)
     {
-        graphExport["serialExecutionOrder"].push_back({
-            { "id", node->mId },
-            { "name", node->name },
-        });
+        return;
     }
 
-    // graphExport["parallelizableNodes"]
-    for (const auto& [nodeId, list] : results.parallelizableNodes)
     {
-        graphExport["parallelizableNodes"].push_back({
-            renderGraph->getPassById(nodeId)->name, list | std::views::transform([&](const Id_t id){ return renderGraph->getPassById(id)->name; }) | std::ranges::to<std::vector<std::string>>(),
-        });
-    }
+        JSONWriter json(file, compact);
+        json.beginObject();
 
-    // graphExport["generatedTasks"]
-    for (const auto& task : results.taskOrder)
-    {
-        graphExport["generatedTasks"].push_back({
-            { "pass", task.pass->name },
-            { "async", std::format("{}", task.asyncPass ? task.asyncPass->name : "null") },
-        });
-    }
+        json.key("compilerOptions");
+        json.beginObject();
+        json.field("allowParallelization", output.options.allowParallelization);
+        json.field("framesInFlight", output.options.framesInFlight);
+        json.field("memoryAwareOrdering", output.options.memoryAwareOrdering);
+        json.field("orderingLookahead", output.options.orderingLookahead);
+        json.field("orderingCandidates", output.options.orderingCandidates);
+        json.field("heapAliasing", output.options.heapAliasing);
+        json.field("planCacheDirectory", output.options.planCacheDirectory.generic_string());
+        json.endObject();
 
-    // graphExport["resourceOptimizerResult"]["resources"]
-    for (const auto& [i, optRes] : std::views::enumerate(results.resourceOptimizer.generatedResources))
-    {
-        graphExport["resourceOptimizerResult"]["resources"].push_back({
-            { "id", optRes.id },
-            { "type", optRes.type },
-            { "usagePoints", json::array() },
-        });
+        json.key("inputGraph");
+        json.beginObject();
+        json.key("nodes");
+        json.beginArray();
+        for (const auto& node : renderGraph->mVertices)
+        {
+            json.beginObject();
+            json.field("id", node->mId);
+            json.field("name", node->name);
+            json.key("dependencies");
+            json.beginArray();
+            for (const auto& resource : node->dependencies)
+            {
+                json.beginObject();
+                json.field("id", resource.id);
+                json.field("name", resource.name);
+                json.field("type", toString(resource.type));
+                json.field("access", toString(resource.access));
+                json.endObject();
+            }
+            json.endArray();
+            json.endObject();
+        }
+        json.endArray();
 
-        for (const auto& usage : optRes.usagePoints)
+        json.key("edges");
+        json.beginArray();
+        for (const auto& edge : renderGraph->mEdges)
         {
-            graphExport["resourceOptimizerResult"]["resources"][i]["usagePoints"].push_back(usage);
+            const auto* srcRes = edge.srcResource();
+            const auto* dstRes = edge.dstResource();
+            if (!srcRes || !dstRes)
+            {
+                continue;
+            }
+
+            json.beginObject();
+            json.field("id", edge.id);
+            json.field("srcNodeId", edge.src->mId);
+            json.field("srcRes", srcRes->name);
+            json.field("dstNodeId", edge.dst->mId);
+            json.field("dstRes", dstRes->name);
+            json.endObject();
         }
-    }
+        json.endArray();
+        json.endObject();
 
-    if (!std::filesystem::exists("export"))
-    {
-        std::filesystem::create_directory("export");
+        json.key("serialExecutionOrder");
+        json.beginArray();
+        for (const auto id : results.serialExecutionOrder)
+        {
+            json.beginObject();
+            json.field("id", id);
+            json.field("name", passNames.at(id));
+            json.endObject();
+        }
+        json.endArray();
+
+        json.key("parallelizableNodes");
+        json.beginArray();
+        for (const auto& [nodeId, list] : results.parallelizableNodes)
+        {
+            json.beginArray();
+            json.value(passNames.at(nodeId));
+            json.beginArray();
+            for (const auto id : list)
+            {
+                json.value(passNames.at(id));
+            }
+            json.endArray();
+            json.endArray();
+        }
+        json.endArray();
+
+        json.key("wavefronts");
+        json.beginArray();
+        for (const auto& level : results.wavefronts.levels)
+        {
+            json.beginArray();
+            for (const auto id : level)
+            {
+                json.value(passNames.at(id));
+            }
+            json.endArray();
+        }
+        json.endArray();
+
+        json.key("generatedTasks");
+        json.beginArray();
+        for (const auto& task : results.taskOrder)
+        {
+            json.beginObject();
+            json.field("pass", task.pass->name);
+            json.field("async", task.asyncPass ? std::string_view(task.asyncPass->name) : "null");
+            json.endObject();
+        }
+        json.endArray();
+
+        const auto& optimizer = results.resourceOptimizer;
+        json.key("resourceOptimizerResult");
+        json.beginObject();
+        json.field("timelineLength", optimizer.timelineRange.end);
+        json.field("preCount", optimizer.preCount);
+        json.field("postCount", optimizer.postCount);
+        json.field("reduction", optimizer.reduction);
+        json.field("liveSetPeak", optimizer.liveSetPeak);
+        json.field("lowerBound", optimizer.lowerBound);
+        json.field("optimalityGap", optimizer.optimalityGap);
+        json.key("resources");
+        json.beginArray();
+        for (const auto& optRes : optimizer.generatedResources)
+        {
+            json.beginObject();
+            json.field("id", optRes.id);
+            json.field("type", toString(optRes.type));
+            json.key("usagePoints");
+            json.beginArray();
+            for (const auto& usage : optRes.usagePoints)
+            {
+                json.beginObject();
+                json.field("point", usage.point);
+                json.field("userResId", usage.userResId);
+                json.field("usedAs", optimizer.nameOf(usage.userResId));
+                json.field("userNodeId", usage.userNodeId);
+                json.field("usedBy", optimizer.nameOf(usage.userNodeId));
+                json.field("access", toString(usage.access));
+                json.endObject();
+            }
+            json.endArray();
+            json.endObject();
+        }
+        json.endArray();
+        json.endObject();
+
+        json.endObject();
     }
-    std::ofstream file("export/graphExport.json");
-    file << std::setw(4) << graphExport << std::endl;
-    file.close();
-#else
-    return;
-#endif
+    std::fclose(file);
 }
 
 void RenderGraphCompilerExport::exportMermaidCompilerOutput(const RGCompilerOutput& output)
@@ -163,29 +229,32 @@ void RenderGraphCompilerExport::exportMermaidCompilerOutput(const RGCompilerOutp
     for (const auto& [i, resource] : std::views::enumerate(output.phaseOutputs->resourceOptimizer.generatedResources))
     {
         out.emplace_back(std::format("\tsection Resource #{}", i));
-        auto usagePoints = std::ranges::to<std::vector<UsagePoint>>(resource.usagePoints);
+        const auto& usagePoints = resource.usagePoints;
+        const auto& optimizer   = output.phaseOutputs->resourceOptimizer;
 
-        for (int32_t j = 1; j < usagePoints.size(); j++)
+        // Points following a write are labeled with the written resource.
+        std::vector<Id_t> usedAs;
+        const UsagePoint* previous = nullptr;
+        for (const auto& usagePoint : usagePoints)
         {
-            if (usagePoints[j - 1].access == AccessType::Write)
-            {
-                usagePoints[j].usedAs = usagePoints[j - 1].usedAs;
-            }
+            usedAs.push_back(previous && previous->access == AccessType::Write ? usedAs.back() : usagePoint.userResId);
+            previous = &usagePoint;
         }
 
         std::map<std::string, Range> usageRanges;
-        for (const auto& usagePoint : usagePoints)
+        for (const auto& [j, usagePoint] : std::views::enumerate(usagePoints))
         {
-            if (!usageRanges.contains(usagePoint.usedAs))
+            const auto label = std::string(optimizer.nameOf(usedAs[j]));
+            if (!usageRanges.contains(label))
             {
                 Range range = {};
                 range.start = usagePoint.point;
                 range.end   = usagePoint.point;
-                usageRanges[usagePoint.usedAs] = range;
+                usageRanges[label] = range;
             }
             else
             {
-                usageRanges[usagePoint.usedAs].end = usagePoint.point;
+                usageRanges[label].end = usagePoint.point;
             }
         }
 
@@ -9,7 +9,8 @@ struct RGCompilerOutput;
 class RenderGraphCompilerExport
 {
 public:
-    static void exportJSONCompilerOutput(const RGCompilerOutput& output, const RenderGraph* renderGraph);
+    /** Stream the compiler output to export/graphExport.json, <compact> omits all whitespace. */
+    static void exportJSONCompilerOutput(const RGCompilerOutput& output, const RenderGraph* renderGraph, bool compact = false);
 
     static void exportMermaidCompilerOutput(const RGCompilerOutput& output);
 };
@@ -24,14 +24,13 @@ void RenderGraphExport::exportMermaid(const RenderGraph* renderGraph)
         output.emplace_back(std::format("{}[{}]:::pass", node->mId, node->name));
         for (const auto& edge : renderGraph->mEdges)
         {
-            if (node->mId == edge.src->mId)
+            const auto* srcRes = edge.srcResource();
+            if (node->mId == edge.src->mId && srcRes)
             {
-                const auto res = std::ranges::find_if(node->dependencies, [&](const Resource& resource){ return resource.name == edge.pSrcRes->name; });
-                const auto type = res->type;
                 output.emplace_back(std::format("{}({}):::{}",
-                    std::format("{}{}", edge.pSrcRes->id, edge.pSrcRes->name),
-                    edge.pSrcRes->name,
-                    type == ResourceType::Image ? "resImage" : "resOther"));
+                    std::format("{}{}", srcRes->id, srcRes->name),
+                    srcRes->name,
+                    srcRes->type == ResourceType::Image ? "resImage" : "resOther"));
             }
         }
     }
@@ -40,15 +39,16 @@ void RenderGraphExport::exportMermaid(const RenderGraph* renderGraph)
     {
         for (const auto& edge : renderGraph->mEdges)
         {
-            if (start->mId == edge.src->mId)
+            const auto* srcRes = edge.srcResource();
+            if (start->mId == edge.src->mId && srcRes)
             {
-                const auto edge1 = std::format("{} --> {}", start->mId, std::format("{}{}", edge.pSrcRes->id, edge.pSrcRes->name));
+                const auto edge1 = std::format("{} --> {}", start->mId, std::format("{}{}", srcRes->id, srcRes->name));
                 if (const auto it = std::ranges::find_if(output, [&edge1](const std::string_view str){ return str == edge1; });
                     it == std::end(output))
                 {
                     output.push_back(edge1);
                 }
-                const auto edge2 = std::format("{} --> {}", std::format("{}{}", edge.pSrcRes->id, edge.pSrcRes->name), edge.dst->mId);
+                const auto edge2 = std::format("{} --> {}", std::format("{}{}", srcRes->id, srcRes->name), edge.dst->mId);
                 if (const auto it = std::ranges::find_if(output, [&edge2](const std::string_view str){ return str == edge2; });
                     it == std::end(output))
                 {
@@ -76,9 +76,8 @@ void RenderGraphExport::exportGraphvizDOT(const RenderGraph* renderGraph)
     std::vector<std::string> output = {"digraph {"};
     for (const auto& start : renderGraph->mVertices)
     {
-        for (const auto& endVtx : start->mOutgoingEdges)
+        for (const auto* end : start->mOutgoingEdges)
         {
-            auto* end = dynamic_cast<Pass*>(endVtx);
             output.emplace_back(std::format(R"("{}" -> "{}")", start->name, end->name));
         }
     }
@@ -94,3 +93,25 @@ void RenderGraphExport::exportGraphvizDOT(const RenderGraph* renderGraph)
         file << s << '\n';
     }
 }
+
+void RenderGraphExport::exportGraphvizDOT(const RenderGraph* renderGraph, const std::vector<std::pair<int32_t, int32_t>>& edges)
+{
+    std::vector<std::string> output = {"digraph {"};
+    for (const auto& [srcId, dstId] : edges)
+    {
+        const auto* start = renderGraph->getPassById(srcId);
+        const auto* end   = renderGraph->getPassById(dstId);
+        output.emplace_back(std::format(R"("{}" -> "{}")", start->name, end->name));
+    }
+    output.emplace_back("}");
+
+    if (!std::filesystem::exists("export"))
+    {
+        std::filesystem::create_directory("export");
+    }
+    std::ofstream file("export/renderGraphReduced.dot");
+    for (const auto& s : output)
+    {
+        file << s << '\n';
+    }
+}
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 class RenderGraph;
 
 class RenderGraphExport
@@ -8,4 +12,7 @@ public:
     static void exportMermaid(const RenderGraph* renderGraph);
 
     static void exportGraphvizDOT(const RenderGraph* renderGraph);
+
+    /** Export only the given (src, dst) pass edges, e.g. the transitive reduction of the graph. */
+    static void exportGraphvizDOT(const RenderGraph* renderGraph, const std::vector<std::pair<int32_t, int32_t>>& edges);
 };
@@ -0,0 +1,243 @@
+#include "RGBinaryGraph.h"
+
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../IdSequence.h"
+#include "../RenderGraph.h"
+#include "../../platform/MappedFile.h"
+
+namespace
+{
+    /** Read a table entry in place, the data only has to be byte aligned. */
+    template <class T>
+    T readEntry(const std::span<const std::byte> data, const size_t tableOffset, const size_t index) noexcept
+    {
+        T value;
+        std::memcpy(&value, data.data() + tableOffset + index * sizeof(T), sizeof(T));
+        return value;
+    }
+
+    bool containsTable(const std::span<const std::byte> data, const size_t offset, const size_t count, const size_t stride) noexcept
+    {
+        return offset <= data.size() && count <= (data.size() - offset) / stride;
+    }
+
+    template <class T>
+    void writeTable(std::ofstream& out, const std::vector<T>& table)
+    {
+        out.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(T)));
+    }
+}
+
+std::expected<std::unique_ptr<RenderGraph>, RGBinaryGraph::Error> RGBinaryGraph::load(const std::span<const std::byte> data)
+{
+    if (data.size() < sizeof(RGBinaryGraphHeader))
+    {
+        return std::unexpected(Error::InvalidHeader);
+    }
+
+    const auto header = readEntry<RGBinaryGraphHeader>(data, 0, 0);
+    if (header.magic != rgBinaryGraphMagic || header.version != rgBinaryGraphVersion || header.endianness != rgBinaryGraphEndianMarker)
+    {
+        return std::unexpected(Error::InvalidHeader);
+    }
+
+    if (!containsTable(data, header.passTableOffset, header.passCount, sizeof(RGBinaryPass))
+        || !containsTable(data, header.resourceTableOffset, header.resourceCount, sizeof(RGBinaryResource))
+        || !containsTable(data, header.edgeTableOffset, header.edgeCount, sizeof(RGBinaryEdge))
+        || !containsTable(data, header.stringPoolOffset, header.stringPoolSize, 1))
+    {
+        return std::unexpected(Error::OutOfBounds);
+    }
+
+    const std::string_view stringPool(reinterpret_cast<const char*>(data.data()) + header.stringPoolOffset, header.stringPoolSize);
+    const auto poolString = [&stringPool](const RGBinaryString str) -> std::optional<std::string_view> {
+        if (str.offset > stringPool.size() || str.length > stringPool.size() - str.offset)
+        {
+            return std::nullopt;
+        }
+        return stringPool.substr(str.offset, str.length);
+    };
+
+    auto renderGraph = std::make_unique<RenderGraph>();
+    renderGraph->reserve(header.passCount, header.edgeCount);
+
+    // Resource table index -> Resource, resources of a pass are never reallocated after its creation.
+    std::vector<Pass*>     passes(header.passCount, nullptr);
+    std::vector<Resource*> resources(header.resourceCount, nullptr);
+    for (uint32_t i = 0; i < header.passCount; i++)
+    {
+        const auto entry = readEntry<RGBinaryPass>(data, header.passTableOffset, i);
+        const auto name  = poolString(entry.name);
+        if (!name.has_value() || entry.firstResource > header.resourceCount || entry.resourceCount > header.resourceCount - entry.firstResource)
+        {
+            return std::unexpected(Error::OutOfBounds);
+        }
+
+        auto pass = std::make_unique<Pass>();
+        pass->mId   = IdSequence::next();
+        pass->name  = name.value();
+        pass->flags = PassFlags::fromBits(static_cast<uint8_t>(entry.flags));
+
+        pass->dependencies.reserve(entry.resourceCount);
+        for (uint32_t r = entry.firstResource; r < entry.firstResource + entry.resourceCount; r++)
+        {
+            const auto resEntry = readEntry<RGBinaryResource>(data, header.resourceTableOffset, r);
+            const auto resName  = poolString(resEntry.name);
+            if (!resName.has_value())
+            {
+                return std::unexpected(Error::OutOfBounds);
+            }
+
+            pass->dependencies.push_back({
+                .id     = IdSequence::next(),
+                .name   = std::string(resName.value()),
+                .type   = static_cast<ResourceType>(resEntry.type),
+                .access = static_cast<AccessType>(resEntry.access),
+                .flags  = { .dontOptimize = resEntry.dontOptimize != 0 },
+                .desc   = {
+                    .size          = resEntry.size,
+                    .compatibility = {
+                        .format  = resEntry.format,
+                        .usage   = resEntry.usage,
+                        .samples = resEntry.samples,
+                    },
+                },
+            });
+        }
+
+        passes[i] = renderGraph->addPass(std::move(pass));
+        for (uint32_t r = 0; r < entry.resourceCount; r++)
+        {
+            resources[entry.firstResource + r] = &passes[i]->dependencies[r];
+        }
+    }
+
+    for (uint32_t i = 0; i < header.edgeCount; i++)
+    {
+        const auto entry = readEntry<RGBinaryEdge>(data, header.edgeTableOffset, i);
+        if (entry.srcPass >= header.passCount || entry.dstPass >= header.passCount
+            || entry.srcResource >= header.resourceCount || entry.dstResource >= header.resourceCount)
+        {
+            return std::unexpected(Error::OutOfBounds);
+        }
+
+        if (!renderGraph->insertEdge(passes[entry.srcPass], resources[entry.srcResource], passes[entry.dstPass], resources[entry.dstResource]))
+        {
+            return std::unexpected(Error::InvalidEdge);
+        }
+    }
+
+    return renderGraph;
+}
+
+std::expected<std::unique_ptr<RenderGraph>, RGBinaryGraph::Error> RGBinaryGraph::loadFile(const std::filesystem::path& path)
+{
+    const auto file = MappedFile::open(path);
+    if (!file.has_value())
+    {
+        return std::unexpected(Error::FileNotFound);
+    }
+    return load(file->data());
+}
+
+bool RGBinaryGraph::write(const RenderGraph& renderGraph, const std::filesystem::path& path)
+{
+    std::string                                          stringPool;
+    std::unordered_map<std::string_view, RGBinaryString> interned;
+    const auto intern = [&](const std::string_view str) {
+        const auto [it, inserted] = interned.try_emplace(str, RGBinaryString {
+            .offset = static_cast<uint32_t>(stringPool.size()),
+            .length = static_cast<uint32_t>(str.size()),
+        });
+        if (inserted)
+        {
+            stringPool.append(str);
+        }
+        return it->second;
+    };
+
+    std::vector<RGBinaryPass>     passes;
+    std::vector<RGBinaryResource> resources;
+    std::vector<RGBinaryEdge>     edges;
+
+    // Pass ID -> Table index
+    std::unordered_map<Id_t, uint32_t> passIdx;
+    for (const auto& pass : renderGraph.getVertices())
+    {
+        passIdx.emplace(pass->mId, static_cast<uint32_t>(passes.size()));
+        passes.push_back({
+            .name          = intern(pass->name),
+            .flags         = pass->flags.bits(),
+            .firstResource = static_cast<uint32_t>(resources.size()),
+            .resourceCount = static_cast<uint32_t>(pass->dependencies.size()),
+        });
+
+        for (const auto& resource : pass->dependencies)
+        {
+            resources.push_back({
+                .name         = intern(resource.name),
+                .type         = static_cast<uint8_t>(resource.type),
+                .access       = static_cast<uint8_t>(resource.access),
+                .dontOptimize = static_cast<uint8_t>(resource.flags.dontOptimize),
+                .reserved     = 0,
+                .format       = resource.desc.compatibility.format,
+                .size         = resource.desc.size,
+                .usage        = resource.desc.compatibility.usage,
+                .samples      = resource.desc.compatibility.samples,
+            });
+        }
+    }
+
+    // Edge resources are resolved through their handles, a stale handle fails the write.
+    for (const auto& edge : renderGraph.getEdges())
+    {
+        const Pass* src = renderGraph.getPass(edge.srcRes.pass);
+        const Pass* dst = renderGraph.getPass(edge.dstRes.pass);
+        if (!renderGraph.getResource(edge.srcRes) || !renderGraph.getResource(edge.dstRes))
+        {
+            return false;
+        }
+
+        const auto srcIdx = passIdx.at(src->mId);
+        const auto dstIdx = passIdx.at(dst->mId);
+        edges.push_back({
+            .srcPass     = srcIdx,
+            .srcResource = passes[srcIdx].firstResource + edge.srcRes.resource,
+            .dstPass     = dstIdx,
+            .dstResource = passes[dstIdx].firstResource + edge.dstRes.resource,
+        });
+    }
+
+    RGBinaryGraphHeader header = {
+        .magic               = rgBinaryGraphMagic,
+        .version             = rgBinaryGraphVersion,
+        .endianness          = rgBinaryGraphEndianMarker,
+        .passCount           = static_cast<uint32_t>(passes.size()),
+        .resourceCount       = static_cast<uint32_t>(resources.size()),
+        .edgeCount           = static_cast<uint32_t>(edges.size()),
+        .stringPoolSize      = static_cast<uint32_t>(stringPool.size()),
+        .passTableOffset     = sizeof(RGBinaryGraphHeader),
+        .resourceTableOffset = 0,
+        .edgeTableOffset     = 0,
+        .stringPoolOffset    = 0,
+        .reserved            = 0,
+    };
+    header.resourceTableOffset = header.passTableOffset + header.passCount * sizeof(RGBinaryPass);
+    header.edgeTableOffset     = header.resourceTableOffset + header.resourceCount * sizeof(RGBinaryResource);
+    header.stringPoolOffset    = header.edgeTableOffset + header.edgeCount * sizeof(RGBinaryEdge);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    writeTable(out, passes);
+    writeTable(out, resources);
+    writeTable(out, edges);
+    out.write(stringPool.data(), static_cast<std::streamsize>(stringPool.size()));
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <span>
+
+#include "../RenderGraphCore.h"
+
+class RenderGraph;
+
+// =======================================
+// Binary Graph Format
+// =======================================
+
+/**
+ * Layout : [Header][Pass table][Resource table][Edge table][String pool]
+ * Offsets are relative to the start of the file, names are (offset, length) ranges of the string pool.
+ * Resources of a pass are stored consecutively, edges reference passes and resources by table index.
+ */
+struct RGBinaryGraphHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t endianness;
+    uint32_t passCount;
+    uint32_t resourceCount;
+    uint32_t edgeCount;
+    uint32_t stringPoolSize;
+    uint32_t passTableOffset;
+    uint32_t resourceTableOffset;
+    uint32_t edgeTableOffset;
+    uint32_t stringPoolOffset;
+    uint32_t reserved;
+};
+
+struct RGBinaryString
+{
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct RGBinaryPass
+{
+    RGBinaryString name;
+    uint32_t       flags;           // RGBinaryPassFlag bits
+    uint32_t       firstResource;
+    uint32_t       resourceCount;
+};
+
+/** Same bits as the packed PassFlags. */
+enum RGBinaryPassFlag : uint32_t
+{
+    RGBinaryPassFlag_Raster    = RGPassFlag_Raster,
+    RGBinaryPassFlag_Compute   = RGPassFlag_Compute,
+    RGBinaryPassFlag_Async     = RGPassFlag_Async,
+    RGBinaryPassFlag_NeverCull = RGPassFlag_NeverCull,
+    RGBinaryPassFlag_Sentinel  = RGPassFlag_Sentinel,
+};
+
+struct RGBinaryResource
+{
+    RGBinaryString name;
+    uint8_t        type;            // ResourceType
+    uint8_t        access;          // AccessType
+    uint8_t        dontOptimize;
+    uint8_t        reserved;
+    uint32_t       format;
+    uint64_t       size;
+    uint32_t       usage;
+    uint32_t       samples;
+};
+
+struct RGBinaryEdge
+{
+    uint32_t srcPass;
+    uint32_t srcResource;
+    uint32_t dstPass;
+    uint32_t dstResource;
+};
+
+constexpr uint32_t rgBinaryGraphMagic        = 0x47424752;    // "RGBG"
+constexpr uint32_t rgBinaryGraphVersion      = 1;
+constexpr uint32_t rgBinaryGraphEndianMarker = 0x01020304;
+
+// =======================================
+// Binary Graph Import / Export
+// =======================================
+class RGBinaryGraph
+{
+public:
+    enum class Error
+    {
+        FileNotFound,
+        InvalidHeader,          // Wrong magic, version or endianness
+        OutOfBounds,            // A table, name or index points outside of the data
+        InvalidEdge,            // Edge between a pass and itself
+    };
+
+    /**
+     * Build a RenderGraph from the binary description, IDs are assigned from IdSequence in table order.
+     * Storage is reserved up front and edges are inserted by index, names are copied out of the string pool.
+     */
+    static std::expected<std::unique_ptr<RenderGraph>, Error> load(std::span<const std::byte> data);
+
+    /** Memory-map the file and load it. */
+    static std::expected<std::unique_ptr<RenderGraph>, Error> loadFile(const std::filesystem::path& path);
+
+    /** Write the binary description of a graph, names are interned in the string pool. */
+    static bool write(const RenderGraph& renderGraph, const std::filesystem::path& path);
+};
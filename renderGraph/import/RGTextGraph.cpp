@@ -0,0 +1,456 @@
+#include "RGTextGraph.h"
+
+#include <algorithm>
+#include <charconv>
+#include <ranges>
+#include <set>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+#include "../IdSequence.h"
+#include "../RenderGraph.h"
+
+namespace
+{
+    using EdgeKey = std::tuple<std::string_view, std::string_view, std::string_view, std::string_view>;
+
+    bool isSpace(const char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    /** Tokenizer over a single line, stops at the end of the line or at a comment. */
+    class LineTokens
+    {
+    public:
+        explicit LineTokens(const std::string_view line)
+        : mRest(line)
+        {
+        }
+
+        /** @return Next token without quotes, empty at the end of the line. */
+        std::string_view next()
+        {
+            skipSpace();
+            if (mRest.empty() || mRest.front() == '#')
+            {
+                return {};
+            }
+
+            if (mRest.front() == '"')
+            {
+                const auto close = mRest.find('"', 1);
+                const auto token = mRest.substr(1, close == std::string_view::npos ? std::string_view::npos : close - 1);
+                mRest.remove_prefix(close == std::string_view::npos ? mRest.size() : close + 1);
+                return token;
+            }
+
+            size_t length = 0;
+            while (length < mRest.size() && !isSpace(mRest[length]))
+            {
+                length++;
+            }
+            const auto token = mRest.substr(0, length);
+            mRest.remove_prefix(length);
+            return token;
+        }
+
+        /** Edge endpoint : ["]pass label["].resource */
+        bool nextEndpoint(std::string_view& pass, std::string_view& resource)
+        {
+            skipSpace();
+            if (!mRest.empty() && mRest.front() == '"')
+            {
+                pass = next();
+                if (mRest.empty() || mRest.front() != '.')
+                {
+                    return false;
+                }
+                mRest.remove_prefix(1);
+                resource = next();
+                return !pass.empty() && !resource.empty();
+            }
+
+            const auto token = next();
+            const auto dot   = token.rfind('.');
+            if (dot == std::string_view::npos)
+            {
+                return false;
+            }
+            pass     = token.substr(0, dot);
+            resource = token.substr(dot + 1);
+            return !pass.empty() && !resource.empty();
+        }
+
+    private:
+        void skipSpace()
+        {
+            while (!mRest.empty() && isSpace(mRest.front()))
+            {
+                mRest.remove_prefix(1);
+            }
+        }
+
+        std::string_view mRest;
+    };
+
+    template <class T>
+    bool parseNumber(const std::string_view str, T& value)
+    {
+        const auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+        return ec == std::errc() && ptr == str.data() + str.size();
+    }
+
+    bool parsePassFlag(const std::string_view token, PassFlags& flags)
+    {
+        if (token == "raster")    { flags.raster    = true; return true; }
+        if (token == "compute")   { flags.compute   = true; return true; }
+        if (token == "async")     { flags.async     = true; return true; }
+        if (token == "neverCull") { flags.neverCull = true; return true; }
+        if (token == "sentinel")  { flags.sentinel  = true; return true; }
+        return false;
+    }
+
+    bool parseResourceType(const std::string_view token, ResourceType& type)
+    {
+        if (token == "image")    { type = ResourceType::Image;    return true; }
+        if (token == "buffer")   { type = ResourceType::Buffer;   return true; }
+        if (token == "external") { type = ResourceType::External; return true; }
+        return false;
+    }
+
+    bool parseAccessType(const std::string_view token, AccessType& access)
+    {
+        if (token == "none")  { access = AccessType::None;  return true; }
+        if (token == "read")  { access = AccessType::Read;  return true; }
+        if (token == "write") { access = AccessType::Write; return true; }
+        return false;
+    }
+
+    bool parseResourceAttribute(const std::string_view token, RGTextResource& resource)
+    {
+        if (token == "dontOptimize")
+        {
+            resource.flags.dontOptimize = true;
+            return true;
+        }
+
+        const auto eq = token.find('=');
+        if (eq == std::string_view::npos)
+        {
+            return false;
+        }
+
+        const auto key   = token.substr(0, eq);
+        const auto value = token.substr(eq + 1);
+        auto& compatibility = resource.desc.compatibility;
+        if (key == "size")    return parseNumber(value, resource.desc.size);
+        if (key == "format")  return parseNumber(value, compatibility.format);
+        if (key == "usage")   return parseNumber(value, compatibility.usage);
+        if (key == "samples") return parseNumber(value, compatibility.samples);
+        return false;
+    }
+
+    bool hasResource(const RGTextGraphDesc& desc, const RGTextPass& pass, const std::string_view name)
+    {
+        const auto resources = desc.resourcesOf(pass);
+        return std::ranges::find(resources, name, &RGTextResource::name) != std::end(resources);
+    }
+
+    Resource* findResource(Pass* pass, const std::string_view name)
+    {
+        const auto it = std::ranges::find_if(pass->dependencies, [name](const Resource& res){ return res.name == name; });
+        return it == std::end(pass->dependencies) ? nullptr : &*it;
+    }
+
+    PassPtr createPass(const RGTextGraphDesc& desc, const RGTextPass& textPass)
+    {
+        auto pass = std::make_unique<Pass>();
+        pass->mId   = IdSequence::next();
+        pass->name  = textPass.label;
+        pass->flags = textPass.flags;
+
+        pass->dependencies.reserve(textPass.resourceCount);
+        for (const auto& resource : desc.resourcesOf(textPass))
+        {
+            pass->dependencies.push_back({
+                .id     = IdSequence::next(),
+                .name   = std::string(resource.name),
+                .type   = resource.type,
+                .access = resource.access,
+                .flags  = resource.flags,
+                .desc   = resource.desc,
+            });
+        }
+        return pass;
+    }
+
+    bool isSamePass(const Pass& pass, const RGTextGraphDesc& desc, const RGTextPass& textPass)
+    {
+        const auto& [raster, compute, async, neverCull, sentinel] = pass.flags;
+        const auto& flags = textPass.flags;
+        if (raster != flags.raster || compute != flags.compute || async != flags.async
+            || neverCull != flags.neverCull || sentinel != flags.sentinel)
+        {
+            return false;
+        }
+
+        return std::ranges::equal(pass.dependencies, desc.resourcesOf(textPass), [](const Resource& lhs, const RGTextResource& rhs) {
+            return lhs.name == rhs.name
+                && lhs.type == rhs.type
+                && lhs.access == rhs.access
+                && lhs.flags.dontOptimize == rhs.flags.dontOptimize
+                && lhs.desc.size == rhs.desc.size
+                && lhs.desc.compatibility == rhs.desc.compatibility;
+        });
+    }
+
+    /** Insert the edges of the description missing from the graph. */
+    int32_t insertEdges(RenderGraph& renderGraph, const RGTextGraphDesc& desc, const std::set<EdgeKey>& existing)
+    {
+        std::unordered_map<std::string_view, Pass*> passByLabel;
+        for (const auto& pass : renderGraph.getVertices())
+        {
+            passByLabel.emplace(pass->name, pass.get());
+        }
+
+        int32_t inserted = 0;
+        for (const auto& edge : desc.edges)
+        {
+            if (existing.contains({ edge.srcPass, edge.srcResource, edge.dstPass, edge.dstResource }))
+            {
+                continue;
+            }
+
+            Pass* src = passByLabel.at(edge.srcPass);
+            Pass* dst = passByLabel.at(edge.dstPass);
+            if (renderGraph.insertEdge(src, findResource(src, edge.srcResource), dst, findResource(dst, edge.dstResource)))
+            {
+                inserted++;
+            }
+        }
+        return inserted;
+    }
+}
+
+std::expected<RGTextGraphDesc, RGTextGraphError> RGTextGraph::parse(const std::string_view source)
+{
+    using enum RGTextGraphError::Kind;
+
+    RGTextGraphDesc desc;
+    std::unordered_map<std::string_view, uint32_t> passByLabel;
+    std::vector<int32_t> edgeLines;
+
+    int32_t lineNumber = 0;
+    size_t  lineStart  = 0;
+    while (lineStart <= source.size())
+    {
+        auto lineEnd = source.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos)
+        {
+            lineEnd = source.size();
+        }
+        lineNumber++;
+
+        LineTokens tokens(source.substr(lineStart, lineEnd - lineStart));
+        lineStart = lineEnd + 1;
+
+        const auto keyword = tokens.next();
+        if (keyword.empty())
+        {
+            continue;
+        }
+
+        const auto error = [lineNumber](const RGTextGraphError::Kind kind) {
+            return std::unexpected(RGTextGraphError { .kind = kind, .line = lineNumber });
+        };
+
+        if (keyword == "pass")
+        {
+            RGTextPass pass = {
+                .label         = tokens.next(),
+                .flags         = {},
+                .firstResource = static_cast<uint32_t>(desc.resources.size()),
+                .resourceCount = 0,
+            };
+            if (pass.label.empty())
+            {
+                return error(UnexpectedToken);
+            }
+
+            for (auto flag = tokens.next(); !flag.empty(); flag = tokens.next())
+            {
+                if (!parsePassFlag(flag, pass.flags))
+                {
+                    return error(UnknownFlag);
+                }
+            }
+
+            if (!passByLabel.emplace(pass.label, static_cast<uint32_t>(desc.passes.size())).second)
+            {
+                return error(DuplicatePass);
+            }
+            desc.passes.push_back(pass);
+            continue;
+        }
+
+        if (keyword == "edge")
+        {
+            RGTextEdge edge;
+            if (!tokens.nextEndpoint(edge.srcPass, edge.srcResource)
+                || tokens.next() != "->"
+                || !tokens.nextEndpoint(edge.dstPass, edge.dstResource)
+                || !tokens.next().empty())
+            {
+                return error(UnexpectedToken);
+            }
+            desc.edges.push_back(edge);
+            edgeLines.push_back(lineNumber);
+            continue;
+        }
+
+        RGTextResource resource;
+        if (!parseResourceType(keyword, resource.type))
+        {
+            return error(UnknownKeyword);
+        }
+        if (desc.passes.empty())
+        {
+            return error(ResourceOutsidePass);
+        }
+
+        resource.name = tokens.next();
+        if (resource.name.empty() || !parseAccessType(tokens.next(), resource.access))
+        {
+            return error(UnexpectedToken);
+        }
+        for (auto attribute = tokens.next(); !attribute.empty(); attribute = tokens.next())
+        {
+            if (!parseResourceAttribute(attribute, resource))
+            {
+                return error(UnexpectedToken);
+            }
+        }
+
+        auto& pass = desc.passes.back();
+        if (hasResource(desc, pass, resource.name))
+        {
+            return error(DuplicateResource);
+        }
+        desc.resources.push_back(resource);
+        pass.resourceCount++;
+    }
+
+    // Edges may reference passes declared after them.
+    for (const auto& [i, edge] : std::views::enumerate(desc.edges))
+    {
+        const auto error = [&edgeLines, i](const RGTextGraphError::Kind kind) {
+            return std::unexpected(RGTextGraphError { .kind = kind, .line = edgeLines[i] });
+        };
+
+        const auto src = passByLabel.find(edge.srcPass);
+        const auto dst = passByLabel.find(edge.dstPass);
+        if (src == std::end(passByLabel) || dst == std::end(passByLabel))
+        {
+            return error(UnknownPass);
+        }
+        if (src->second == dst->second)
+        {
+            return error(InvalidEdge);
+        }
+        if (!hasResource(desc, desc.passes[src->second], edge.srcResource)
+            || !hasResource(desc, desc.passes[dst->second], edge.dstResource))
+        {
+            return error(UnknownResource);
+        }
+    }
+
+    return desc;
+}
+
+std::unique_ptr<RenderGraph> RGTextGraph::build(const RGTextGraphDesc& desc)
+{
+    auto renderGraph = std::make_unique<RenderGraph>();
+    renderGraph->reserve(desc.passes.size(), desc.edges.size());
+    for (const auto& pass : desc.passes)
+    {
+        renderGraph->addPass(createPass(desc, pass));
+    }
+    insertEdges(*renderGraph, desc, {});
+    return renderGraph;
+}
+
+RGTextGraphReloadStats RGTextGraph::reload(RenderGraph& renderGraph, const RGTextGraphDesc& desc)
+{
+    RGTextGraphReloadStats stats;
+
+    std::unordered_map<std::string_view, const RGTextPass*> textPassByLabel;
+    for (const auto& pass : desc.passes)
+    {
+        textPassByLabel.emplace(pass.label, &pass);
+    }
+
+    // Delete removed and changed passes, deleting a pass also deletes its edges.
+    std::vector<Id_t> stalePasses;
+    std::set<std::string_view> livePasses;
+    for (const auto& pass : renderGraph.getVertices())
+    {
+        const auto textPass = textPassByLabel.find(pass->name);
+        if (textPass == std::end(textPassByLabel) || !isSamePass(*pass, desc, *textPass->second))
+        {
+            stalePasses.push_back(pass->mId);
+            continue;
+        }
+        livePasses.insert(textPass->first);
+    }
+
+    for (const auto passId : stalePasses)
+    {
+        const auto* pass = renderGraph.getPassById(passId);
+        stats.removedEdges += static_cast<int32_t>(std::ranges::count_if(renderGraph.getEdges(), [pass](const Edge& edge) {
+            return edge.src == pass || edge.dst == pass;
+        }));
+        renderGraph.deletePass(passId);
+        stats.removedPasses++;
+    }
+
+    for (const auto& pass : desc.passes)
+    {
+        if (!livePasses.contains(pass.label))
+        {
+            renderGraph.addPass(createPass(desc, pass));
+            stats.addedPasses++;
+        }
+    }
+
+    // Delete edges between unchanged passes which are no longer described.
+    const std::set<EdgeKey> describedEdges = desc.edges
+        | std::views::transform([](const RGTextEdge& edge){ return EdgeKey { edge.srcPass, edge.srcResource, edge.dstPass, edge.dstResource }; })
+        | std::ranges::to<std::set<EdgeKey>>();
+
+    std::vector<RGEdgeHandle> staleEdges;
+    std::set<EdgeKey> liveEdges;
+    for (const auto& edge : renderGraph.getEdges())
+    {
+        const auto* srcRes = edge.srcResource();
+        const auto* dstRes = edge.dstResource();
+        if (!srcRes || !dstRes)
+        {
+            staleEdges.push_back(edge.handle);
+            continue;
+        }
+
+        const EdgeKey key = { edge.src->name, srcRes->name, edge.dst->name, dstRes->name };
+        if (describedEdges.contains(key))
+        {
+            liveEdges.insert(key);
+            continue;
+        }
+        staleEdges.push_back(edge.handle);
+    }
+    stats.removedEdges += renderGraph.deleteEdges(staleEdges);
+
+    stats.addedEdges = insertEdges(renderGraph, desc, liveEdges);
+    return stats;
+}
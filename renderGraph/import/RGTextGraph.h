@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "../RenderGraphCore.h"
+
+class RenderGraph;
+
+// =======================================
+// Text Graph Format
+// =======================================
+
+/**
+ * Line based, '#' starts a comment. Pass labels are quoted if they contain spaces and must be unique.
+ *
+ *   pass "G-Buffer Pass" raster
+ *       external scene none
+ *       image positionImage write size=1024 format=37 usage=7 samples=1
+ *   pass "Lighting Pass" raster compute
+ *       image positionImage read dontOptimize
+ *   edge "G-Buffer Pass".positionImage -> "Lighting Pass".positionImage
+ *
+ * Pass flags : raster, compute, async, neverCull, sentinel
+ * Resource types : image, buffer, external, Access types : none, read, write
+ */
+struct RGTextResource
+{
+    std::string_view name;
+    ResourceType     type   = ResourceType::Unknown;
+    AccessType       access = AccessType::None;
+    ResourceFlags    flags;
+    ResourceDesc     desc;
+};
+
+struct RGTextPass
+{
+    std::string_view label;
+    PassFlags        flags;
+    uint32_t         firstResource = 0;
+    uint32_t         resourceCount = 0;
+};
+
+struct RGTextEdge
+{
+    std::string_view srcPass;
+    std::string_view srcResource;
+    std::string_view dstPass;
+    std::string_view dstResource;
+};
+
+/** Parsed graph description, all names view into the parsed source. */
+struct RGTextGraphDesc
+{
+    std::vector<RGTextPass>     passes;
+    std::vector<RGTextResource> resources;
+    std::vector<RGTextEdge>     edges;
+
+    std::span<const RGTextResource> resourcesOf(const RGTextPass& pass) const
+    {
+        return std::span(resources).subspan(pass.firstResource, pass.resourceCount);
+    }
+};
+
+struct RGTextGraphError
+{
+    enum class Kind
+    {
+        UnexpectedToken,
+        UnknownKeyword,
+        UnknownFlag,
+        ResourceOutsidePass,
+        DuplicatePass,
+        DuplicateResource,
+        UnknownPass,
+        UnknownResource,
+        InvalidEdge,
+    };
+
+    Kind    kind;
+    int32_t line;       // 1-based line of the source the error was found on
+};
+
+/** Passes and edges touched by a reload. */
+struct RGTextGraphReloadStats
+{
+    int32_t addedPasses   = 0;
+    int32_t removedPasses = 0;
+    int32_t addedEdges    = 0;
+    int32_t removedEdges  = 0;
+};
+
+// =======================================
+// Text Graph Import
+// =======================================
+class RGTextGraph
+{
+public:
+    /**
+     * Single pass over the source, tokens are views into it and nothing is allocated per token.
+     * Edges are validated against the declared passes and resources.
+     */
+    static std::expected<RGTextGraphDesc, RGTextGraphError> parse(std::string_view source);
+
+    /** Build a new RenderGraph from a description. */
+    static std::unique_ptr<RenderGraph> build(const RGTextGraphDesc& desc);
+
+    /**
+     * Update a live graph built from an earlier version of the description, passes are matched by label.
+     * Removed or changed passes are deleted and changed or new ones added, only edges which differ are touched.
+     * Unchanged passes keep their IDs and resources.
+     */
+    static RGTextGraphReloadStats reload(RenderGraph& renderGraph, const RGTextGraphDesc& desc);
+};